@@ -0,0 +1,553 @@
+/*
+Parse (and format) throughput benchmarks. Every parser engine runs over the same corpora so the results can be compared
+side by side. Besides the usual timings, each benchmark reports:
+
+    time/stamp      average time to parse one stamp
+    allocs/stamp    average number of heap allocations per stamp
+    parsed          fraction of the corpus that parsed
+
+Extra flags, in addition to the Google Benchmark ones:
+
+    --rfc882_corpus=<file>      also run over a corpus file with one stamp per line
+    --rfc882_malformed=<n>      percentage of malformed stamps in the generated corpora (default: 0 and 10)
+    --rfc882_size=<n>           number of stamps per generated corpus (default: 4096)
+*/
+
+#include <algorithm> // for std::sort()
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "rfc882corpus.h"
+#include "../rfc882cache.h"
+#include "../rfc882datetime.h"
+#include "../rfc882find.h"
+#include "../rfc882format.h"
+#include "../rfc882http.h"
+#include "../rfc882lazy.h"
+#include "../rfc882parallel.h"
+#include "../rfc882parser.h"
+#include "../rfc882pipeline.h"
+#include "../rfc882pmr.h"
+#include "../rfc882prefilter.h"
+#include "../rfc882regex.h"
+#include "../rfc882scanner.h"
+#include "../rfc882sequential.h"
+#include "../rfc882simd.h"
+#include "../rfc882sort.h"
+#include "../rfc882stream.h"
+
+namespace
+{
+    std::atomic<std::size_t> allocationCount{ 0 };
+}
+
+// Count every heap allocation in the process.
+// GCC can't tell that the replacement operator delete pairs with the malloc() below.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace rfc882::bench
+{
+    namespace
+    {
+        struct Corpus
+        {
+            std::string name;
+            std::vector<std::string> stamps;
+            std::vector<std::string_view> views;
+        };
+
+        // Run engine over the whole corpus once per iteration. engine returns true if the stamp parsed.
+        template <class Engine>
+        void runEngine(benchmark::State& state, const Corpus& corpus, Engine engine)
+        {
+            std::size_t parsed = 0;
+            const std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            for(auto _ : state)
+            {
+                for(std::size_t i = 0; i < corpus.stamps.size(); ++i)
+                    parsed += engine(corpus.stamps[i], corpus.views[i]);
+            }
+            const std::size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+            const double stamps = static_cast<double>(state.iterations()) * static_cast<double>(corpus.stamps.size());
+            state.SetItemsProcessed(static_cast<std::int64_t>(stamps));
+            state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(corpus.stamps.size()),
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+            state.counters["allocs/stamp"] = static_cast<double>(allocations) / stamps;
+            state.counters["parsed"] = static_cast<double>(parsed) / stamps;
+        }
+
+        // Run batch (with the signature of parseBatch()) over the whole corpus once per iteration.
+        template <class Batch>
+        void runBatchEngine(benchmark::State& state, const Corpus& corpus, Batch batch)
+        {
+            std::vector<std::chrono::system_clock::time_point> times(corpus.views.size());
+            std::vector<std::int16_t> differentials(corpus.views.size());
+            std::vector<std::uint8_t> valid((corpus.views.size() + 7) / 8);
+
+            std::size_t parsed = 0;
+            for(auto _ : state)
+            {
+                parsed += batch(corpus.views.data(), corpus.views.size(), BatchOutput{ times.data(), differentials.data(), valid.data() });
+                benchmark::DoNotOptimize(times.data());
+                benchmark::ClobberMemory();
+            }
+
+            const double stamps = static_cast<double>(state.iterations()) * static_cast<double>(corpus.views.size());
+            state.SetItemsProcessed(static_cast<std::int64_t>(stamps));
+            state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(corpus.views.size()),
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+            state.counters["parsed"] = static_cast<double>(parsed) / stamps;
+        }
+
+        // Run the corpus as one newline-separated stream through run(stream, chunkSize), which returns the number of
+        // stamps that parsed, once per iteration
+        template <class Run>
+        void runStreamEngine(benchmark::State& state, const Corpus& corpus, Run run)
+        {
+            std::string stream;
+            for(const auto& stamp : corpus.stamps)
+                (stream += stamp) += '\n';
+            constexpr std::size_t chunkSize = 4096;
+
+            std::size_t parsed = 0;
+            const std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            for(auto _ : state)
+                parsed += run(std::string_view{ stream }, chunkSize);
+            const std::size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+            const double stamps = static_cast<double>(state.iterations()) * static_cast<double>(corpus.stamps.size());
+            state.SetItemsProcessed(static_cast<std::int64_t>(stamps));
+            state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(stream.size()));
+            state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(corpus.stamps.size()),
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+            state.counters["allocs/stamp"] = static_cast<double>(allocations) / stamps;
+            state.counters["parsed"] = static_cast<double>(parsed) / stamps;
+        }
+
+        // Run the calendar kernel over the dates of the stamps of the corpus that scan, once per iteration
+        void runCalendarEngine(benchmark::State& state, const Corpus& corpus, detail::DateTimeKernel kernel)
+        {
+            std::vector<RFC882DateTime::DateTime> dates;
+            for(std::string_view stamp : corpus.views)
+            {
+                ParseResult result;
+                if(detail::scanFixedLayout(stamp, result) || detail::scanDateAndTimeSpec(stamp, result))
+                    dates.push_back(result.dateTime);
+            }
+            std::vector<std::chrono::system_clock::time_point> times(dates.size());
+            std::vector<std::uint8_t> valid(dates.size());
+
+            std::size_t parsed = 0;
+            for(auto _ : state)
+            {
+                parsed += kernel(dates.data(), dates.size(), times.data(), valid.data());
+                benchmark::DoNotOptimize(times.data());
+                benchmark::ClobberMemory();
+            }
+
+            const double converted = static_cast<double>(state.iterations()) * static_cast<double>(dates.size());
+            state.SetItemsProcessed(static_cast<std::int64_t>(converted));
+            state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(dates.size()),
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+            state.counters["parsed"] = converted ? static_cast<double>(parsed) / converted : 0;
+        }
+
+        void registerEngines(const Corpus& corpus)
+        {
+            const auto name = [&corpus](const char* engine) { return std::string{ engine } + "/" + corpus.name; };
+
+            // What parseDateAndTimeSpecRegex() used to do: compile the pattern for every stamp
+            benchmark::RegisterBenchmark(name("regexCompilePerCall").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string& stamp, std::string_view) {
+                    const std::regex pattern{ detail::rfc882RegexPattern };
+                    return RegexParser{ pattern }.parse(stamp).has_value();
+                });
+            });
+
+            // The pattern compiled once, and a parser per thread
+            benchmark::RegisterBenchmark(name("regex").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string& stamp, std::string_view) {
+                    return parseDateAndTimeSpecRegex(stamp).has_value();
+                });
+            });
+
+            benchmark::RegisterBenchmark(name("parseDateAndTimeSpec").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string& stamp, std::string_view) {
+                    return parseDateAndTimeSpec(stamp).has_value();
+                });
+            });
+
+            // The strings on an arena that is released every 256 stamps, as a feed batch would be
+            benchmark::RegisterBenchmark(name("parseDateAndTimeSpecArena").c_str(), [&corpus](benchmark::State& state) {
+                std::vector<std::byte> buffer(64 * 1024);
+                std::pmr::monotonic_buffer_resource arena{ buffer.data(), buffer.size() };
+                std::size_t count = 0;
+                runEngine(state, corpus, [&arena, &count](const std::string&, std::string_view stamp) {
+                    if(++count % 256 == 0)
+                        arena.release();
+                    return parseDateAndTimeSpec(stamp, &arena).has_value();
+                });
+            });
+
+            // Only the time is read, as most callers do
+            benchmark::RegisterBenchmark(name("parseDateAndTimeSpecLazy").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string& stamp, std::string_view) {
+                    const auto date = parseDateAndTimeSpecLazy(stamp);
+                    if(date)
+                        benchmark::DoNotOptimize(date->time());
+                    return date.has_value();
+                });
+            });
+
+            benchmark::RegisterBenchmark(name("parse").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    const ParseResult result = parse(stamp);
+                    benchmark::DoNotOptimize(result);
+                    return result.valid;
+                });
+            });
+
+            // Corpora with few distinct stamps are where the cache pays off; the hit rate shows how far
+            benchmark::RegisterBenchmark(name("parseCached").c_str(), [&corpus](benchmark::State& state) {
+                resetCache();
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    const ParseResult result = parseCached(stamp);
+                    benchmark::DoNotOptimize(result);
+                    return result.valid;
+                });
+
+                const CacheStats stats = cacheStats();
+                const std::uint64_t lookups = stats.stampHits + stats.stampMisses;
+                state.counters["stampHits"] = lookups == 0 ? 0.0 : static_cast<double>(stats.stampHits) / static_cast<double>(lookups);
+            });
+
+            // Each stamp against the one before, which pays off on the log corpus; the fractions show which path the stamps took
+            benchmark::RegisterBenchmark(name("sequential").c_str(), [&corpus](benchmark::State& state) {
+                SequentialParser parser;
+                runEngine(state, corpus, [&parser](const std::string&, std::string_view stamp) {
+                    const ParseResult result = parser.parse(stamp);
+                    benchmark::DoNotOptimize(result);
+                    return result.valid;
+                });
+
+                const SequentialStats& stats = parser.stats();
+                const double total = static_cast<double>(stats.repeated + stats.timeDigits + stats.timeScanned + stats.parsed);
+                if(total != 0)
+                {
+                    state.counters["repeated"] = static_cast<double>(stats.repeated) / total;
+                    state.counters["timeDigits"] = static_cast<double>(stats.timeDigits) / total;
+                    state.counters["timeScanned"] = static_cast<double>(stats.timeScanned) / total;
+                }
+            });
+
+            // The scanner specialized to a dialect, with the extended zone table
+            benchmark::RegisterBenchmark(name("extendedParser").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    return ExtendedParser::parse(stamp).valid;
+                });
+            });
+
+            // HTTP-dates, which only parse in the http corpus (IMF-fixdate also in the fixed one)
+            benchmark::RegisterBenchmark(name("parseHttpDate").c_str(), [&corpus](benchmark::State& state) {
+                const auto now = std::chrono::system_clock::now();
+                runEngine(state, corpus, [now](const std::string&, std::string_view stamp) {
+                    const ParseResult result = parseHttpDate(stamp, now);
+                    benchmark::DoNotOptimize(result);
+                    return result.valid;
+                });
+            });
+
+            benchmark::RegisterBenchmark(name("parseImfFixdate").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    const ParseResult result = parseImfFixdate(stamp);
+                    benchmark::DoNotOptimize(result);
+                    return result.valid;
+                });
+            });
+
+            // Grammar only: no calendar validation or time point
+            benchmark::RegisterBenchmark(name("scanner").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    ParseResult result;
+                    const bool scanned = detail::scanDateAndTimeSpec(stamp, result);
+                    benchmark::DoNotOptimize(result);
+                    return scanned;
+                });
+            });
+
+            // Grammar only, and only stamps with a fixed layout get through
+            benchmark::RegisterBenchmark(name("fixedLayout").c_str(), [&corpus](benchmark::State& state) {
+                state.SetLabel(detail::fixedLayoutKernelName());
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    ParseResult result;
+                    const bool scanned = detail::scanFixedLayout(stamp, result);
+                    benchmark::DoNotOptimize(result);
+                    return scanned;
+                });
+            });
+
+            // Calendar validation and conversion only, of the dates that scan
+            benchmark::RegisterBenchmark(name("calendar").c_str(), [&corpus](benchmark::State& state) {
+                state.SetLabel(detail::dateTimeKernelName());
+                runCalendarEngine(state, corpus, detail::dateTimeKernel());
+            });
+
+            benchmark::RegisterBenchmark(name("calendarScalar").c_str(), [&corpus](benchmark::State& state) {
+                runCalendarEngine(state, corpus, detail::convertDateTimesScalar);
+            });
+
+            // Rejection only: "parsed" is the fraction of the corpus that gets through
+            benchmark::RegisterBenchmark(name("prefilter").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    return prefilter(stamp) == RejectReason::none;
+                });
+            });
+
+            // What a router does: prefilter, then parse the candidates
+            benchmark::RegisterBenchmark(name("prefilterParse").c_str(), [&corpus](benchmark::State& state) {
+                runEngine(state, corpus, [](const std::string&, std::string_view stamp) {
+                    return prefilter(stamp) == RejectReason::none && parse(stamp).valid;
+                });
+            });
+
+            benchmark::RegisterBenchmark(name("parseBatch").c_str(), [&corpus](benchmark::State& state) {
+                runBatchEngine(state, corpus, [](const std::string_view* stamps, std::size_t count, const BatchOutput& out) {
+                    return parseBatch(stamps, count, out);
+                });
+            });
+
+            benchmark::RegisterBenchmark(name("parseBatchParallel").c_str(), [&corpus](benchmark::State& state) {
+                state.SetLabel(std::to_string(std::thread::hardware_concurrency()) + " threads");
+                runBatchEngine(state, corpus, [](const std::string_view* stamps, std::size_t count, const BatchOutput& out) {
+                    return parseBatchParallel(stamps, count, out);
+                });
+            });
+
+            // The corpus as one newline-separated stream, fed in read()-sized chunks so that some stamps straddle them
+            benchmark::RegisterBenchmark(name("stream").c_str(), [&corpus](benchmark::State& state) {
+                runStreamEngine(state, corpus, [](std::string_view stream, std::size_t chunkSize) {
+                    std::size_t parsed = 0;
+                    StreamParser parser;
+                    const auto onStamp = [&parsed](const ParseResult& result) { parsed += result.valid; };
+                    for(std::size_t offset = 0; offset < stream.size(); offset += chunkSize)
+                        parser.feed(stream.substr(offset, chunkSize), onStamp);
+                    parser.finish(onStamp);
+                    return parsed;
+                });
+            });
+
+            // The same chunks, split into batches for parseBatch()
+            benchmark::RegisterBenchmark(name("pipeline").c_str(), [&corpus](benchmark::State& state) {
+                ParsePipeline pipeline;
+                runStreamEngine(state, corpus, [&pipeline](std::string_view stream, std::size_t chunkSize) {
+                    std::size_t parsed = 0;
+                    pipeline.reset();
+                    const auto onBatch = [&parsed](const ParsedBatch& batch) { parsed += batch.parsed; };
+                    for(std::size_t offset = 0; offset < stream.size(); offset += chunkSize)
+                        pipeline.feed(stream.substr(offset, chunkSize), onBatch);
+                    pipeline.finish(onBatch);
+                    return parsed;
+                });
+            });
+        }
+
+        // Finding the stamps of the corpus inside mail headers: with findAll(), and the way callers did it before,
+        // with std::regex_search() over the text and then parseDateAndTimeSpec() on every match
+        void registerFinders(const Corpus& corpus)
+        {
+            std::string text;
+            for(const auto& stamp : corpus.stamps)
+                text += "Received: from mail.example.com (10.1.2.3:25) by mx.example.org; " + stamp + "\r\nDate: " + stamp + "\r\n";
+
+            const auto report = [&corpus, size = text.size()](benchmark::State& state, std::size_t found) {
+                const double stamps = static_cast<double>(state.iterations()) * static_cast<double>(2 * corpus.stamps.size());
+                state.SetItemsProcessed(static_cast<std::int64_t>(stamps));
+                state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(size));
+                state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(2 * corpus.stamps.size()),
+                    benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+                state.counters["parsed"] = static_cast<double>(found) / stamps;
+            };
+
+            benchmark::RegisterBenchmark(("findAll/" + corpus.name).c_str(), [text, report](benchmark::State& state) {
+                std::size_t found = 0;
+                for(auto _ : state)
+                    found += findAll(text, [](const FoundStamp& stamp) { benchmark::DoNotOptimize(stamp.result.time); });
+                report(state, found);
+            });
+
+            benchmark::RegisterBenchmark(("findRegex/" + corpus.name).c_str(), [text, report](benchmark::State& state) {
+                const std::regex pattern{ detail::rfc882RegexPattern };
+                std::size_t found = 0;
+                for(auto _ : state)
+                {
+                    for(std::sregex_iterator match{ text.begin(), text.end(), pattern }, end; match != end; ++match)
+                        found += parseDateAndTimeSpec(match->str()).has_value();
+                }
+                report(state, found);
+            });
+        }
+
+        void registerFormatter(const Corpus& corpus)
+        {
+            benchmark::RegisterBenchmark(("format/" + corpus.name).c_str(), [&corpus](benchmark::State& state) {
+                std::vector<std::chrono::system_clock::time_point> times(corpus.views.size());
+                std::vector<std::int16_t> differentials(corpus.views.size());
+                parseBatch(corpus.views.data(), corpus.views.size(), { times.data(), differentials.data(), nullptr });
+                std::vector<char> out(corpus.views.size() * formattedSize);
+
+                const std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+                for(auto _ : state)
+                {
+                    formatBatch(times.data(), differentials.data(), times.size(), out.data());
+                    benchmark::DoNotOptimize(out.data());
+                    benchmark::ClobberMemory();
+                }
+                const std::size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+                const double stamps = static_cast<double>(state.iterations()) * static_cast<double>(times.size());
+                state.SetItemsProcessed(static_cast<std::int64_t>(stamps));
+                state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(times.size()),
+                    benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+                state.counters["allocs/stamp"] = static_cast<double>(allocations) / stamps;
+            });
+        }
+
+        // Sorting stamps by time: through RFC882DateTime objects, and through sort keys
+        void registerSorters(const Corpus& corpus)
+        {
+            const auto report = [&corpus](benchmark::State& state) {
+                const double stamps = static_cast<double>(state.iterations()) * static_cast<double>(corpus.stamps.size());
+                state.SetItemsProcessed(static_cast<std::int64_t>(stamps));
+                state.counters["time/stamp"] = benchmark::Counter(static_cast<double>(corpus.stamps.size()),
+                    benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+            };
+
+            benchmark::RegisterBenchmark(("sort/RFC882DateTime/" + corpus.name).c_str(), [&corpus, report](benchmark::State& state) {
+                for(auto _ : state)
+                {
+                    std::vector<RFC882DateTime> dates;
+                    dates.reserve(corpus.stamps.size());
+                    for(const auto& stamp : corpus.stamps)
+                    {
+                        if(auto date = parseDateAndTimeSpec(stamp))
+                            dates.push_back(std::move(*date));
+                    }
+                    std::sort(dates.begin(), dates.end());
+                    benchmark::DoNotOptimize(dates.data());
+                }
+                report(state);
+            });
+
+            benchmark::RegisterBenchmark(("sort/radixSort/" + corpus.name).c_str(), [&corpus, report](benchmark::State& state) {
+                std::vector<std::uint64_t> keys(corpus.views.size());
+                std::vector<std::uint32_t> order(corpus.views.size());
+                for(auto _ : state)
+                {
+                    sortKeys(corpus.views.data(), corpus.views.size(), keys.data());
+                    for(std::size_t i = 0; i < order.size(); ++i)
+                        order[i] = static_cast<std::uint32_t>(i);
+                    radixSort(keys.data(), order.data(), keys.size());
+                    benchmark::DoNotOptimize(order.data());
+                }
+                report(state);
+            });
+        }
+
+        Corpus makeNamedCorpus(std::string name, std::vector<std::string> stamps)
+        {
+            Corpus corpus{ std::move(name), std::move(stamps), {} };
+            corpus.views.assign(corpus.stamps.begin(), corpus.stamps.end());
+            return corpus;
+        }
+
+        // Returns the value of --<flag>=<value> and removes it from argv, or fallback if it isn't there.
+        std::string takeFlag(int& argc, char** argv, std::string_view flag, std::string fallback)
+        {
+            const std::string prefix = "--" + std::string{ flag } + "=";
+            for(int i = 1; i < argc; ++i)
+            {
+                if(std::string_view{ argv[i] }.substr(0, prefix.size()) == prefix)
+                {
+                    std::string value = argv[i] + prefix.size();
+                    for(int j = i; j + 1 < argc; ++j)
+                        argv[j] = argv[j + 1];
+                    --argc;
+                    return value;
+                }
+            }
+            return fallback;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace rfc882::bench;
+
+    const std::string corpusFile = takeFlag(argc, argv, "rfc882_corpus", "");
+    const std::string malformed = takeFlag(argc, argv, "rfc882_malformed", "");
+    const std::size_t size = std::stoul(takeFlag(argc, argv, "rfc882_size", "4096"));
+
+    std::vector<unsigned> malformedPercents{ 0, 10 };
+    if(!malformed.empty())
+        malformedPercents = { static_cast<unsigned>(std::stoul(malformed)) };
+
+    // Registered benchmarks keep references to the corpora, so they must not move after registration
+    std::vector<Corpus> corpora;
+    for(auto kind : { CorpusKind::fixed, CorpusKind::rss, CorpusKind::rfc822, CorpusKind::zones, CorpusKind::mixed, CorpusKind::feed, CorpusKind::http, CorpusKind::log })
+    {
+        for(unsigned percent : malformedPercents)
+        {
+            corpora.push_back(makeNamedCorpus(std::string{ corpusName(kind) } + "/malformed:" + std::to_string(percent),
+                makeCorpus(kind, size, percent)));
+        }
+    }
+    if(!corpusFile.empty())
+        corpora.push_back(makeNamedCorpus("file", loadCorpus(corpusFile)));
+
+    for(const auto& corpus : corpora)
+    {
+        registerEngines(corpus);
+        registerFinders(corpus);
+    }
+    registerFormatter(corpora.front());
+    registerSorters(corpora.front());
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
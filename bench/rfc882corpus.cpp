@@ -0,0 +1,265 @@
+#include <algorithm> // for std::min()
+#include <cstdint>
+#include <cstdio> // for std::snprintf()
+#include <cstdlib> // for std::abs()
+#include <fstream>
+#include <iterator> // for std::size()
+#include <random>
+
+#include "rfc882corpus.h"
+#include "../rfc882calendar.h"
+#include "../rfc882tables.h"
+
+namespace rfc882::bench
+{
+    namespace
+    {
+        constexpr std::string_view namedZones[] = { "UT", "GMT", "EST", "EDT", "CST", "CDT", "MST", "MDT", "PST", "PDT", "Z", "A", "M", "N", "Y" };
+
+        struct Shape
+        {
+            bool dayOfWeek = true;
+            bool twoDigitDay = true;
+            bool fourDigitYear = true;
+            bool seconds = true;
+            bool namedZone = false;
+            bool gmtOnly = false;           // named zones are always GMT
+            bool irregularSpace = false;
+            bool recentDates = false;       // dates within a few weeks instead of 1970 - 2099
+        };
+
+        class Generator
+        {
+        public:
+            explicit Generator(unsigned seed) : rng_{ seed } {}
+
+            bool chance(unsigned percent) { return uniform(0, 99) < static_cast<int>(percent); }
+
+            int uniform(int low, int high) { return std::uniform_int_distribution<int>{ low, high }(rng_); }
+
+            std::string stamp(const Shape& shape)
+            {
+                int year = shape.fourDigitYear ? uniform(1970, 2037) : uniform(2000, 2099);
+                int month = uniform(1, 12);
+                int day = uniform(1, 28);
+                if(shape.recentDates)
+                {
+                    year = 2014;
+                    month = 10;
+                    day = uniform(1, 14);
+                }
+
+                // days_from_civil() based weekday, so stamps are also valid under strict weekday checking
+                const int weekday = weekdayOf(year, month, day);
+
+                const char* space = shape.irregularSpace ? (chance(50) ? "  " : "\t") : " ";
+                std::string result;
+                if(shape.dayOfWeek)
+                {
+                    result += weekdayName(weekday);
+                    result += ',';
+                    result += space;
+                }
+
+                char buffer[64];
+                std::snprintf(buffer, sizeof(buffer), shape.twoDigitDay ? "%02d%s" : "%d%s", day, space);
+                result += buffer;
+                result += monthName(month);
+                std::snprintf(buffer, sizeof(buffer), "%s%0*d%s%02d:%02d", space, shape.fourDigitYear ? 4 : 2,
+                    shape.fourDigitYear ? year : year % 100, space, uniform(0, 23), uniform(0, 59));
+                result += buffer;
+                if(shape.seconds)
+                {
+                    std::snprintf(buffer, sizeof(buffer), ":%02d", uniform(0, 59));
+                    result += buffer;
+                }
+                result += space;
+
+                if(shape.namedZone)
+                {
+                    result += shape.gmtOnly ? "GMT" : namedZones[uniform(0, static_cast<int>(std::size(namedZones)) - 1)];
+                }
+                else
+                {
+                    const int minutes = uniform(-12 * 60, 14 * 60) / 15 * 15;
+                    std::snprintf(buffer, sizeof(buffer), "%c%02d%02d", minutes < 0 ? '-' : '+', std::abs(minutes) / 60, std::abs(minutes) % 60);
+                    result += buffer;
+                }
+                return result;
+            }
+
+            std::string httpStamp()
+            {
+                static const char* const longWeekdayNames[] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+                const int year = uniform(1995, 2037);
+                const int month = uniform(1, 12);
+                const int day = uniform(1, 28);
+                const int weekday = weekdayOf(year, month, day);
+
+                char buffer[64];
+                const int form = uniform(0, 99);
+                if(form < 90)
+                {
+                    std::snprintf(buffer, sizeof(buffer), "%s, %02d %s %04d %02d:%02d:%02d GMT", weekdayName(weekday).data(), day,
+                        monthName(month).data(), year, uniform(0, 23), uniform(0, 59), uniform(0, 59));
+                }
+                else if(form < 95)
+                {
+                    std::snprintf(buffer, sizeof(buffer), "%s, %02d-%s-%02d %02d:%02d:%02d GMT", longWeekdayNames[weekday], day,
+                        monthName(month).data(), year % 100, uniform(0, 23), uniform(0, 59), uniform(0, 59));
+                }
+                else
+                {
+                    std::snprintf(buffer, sizeof(buffer), "%s %s %2d %02d:%02d:%02d %04d", weekdayName(weekday).data(),
+                        monthName(month).data(), day, uniform(0, 23), uniform(0, 59), uniform(0, 59), year);
+                }
+                return buffer;
+            }
+
+            // The stamp of a log line seconds after the start of the log, in a zone 2 hours ahead of UTC
+            std::string logStamp(std::int64_t seconds)
+            {
+                const std::int64_t days = days_from_civil<std::int64_t>(2014, 10, 7) + seconds / 86400;
+                const civil_date<std::int64_t> date = civil_from_days(days);
+                const int secondOfDay = static_cast<int>(seconds % 86400);
+
+                char buffer[64];
+                std::snprintf(buffer, sizeof(buffer), "%s, %02u %s %04lld %02d:%02d:%02d +0200", weekdayName(static_cast<int>(weekday_from_days(days))).data(),
+                    date.d, monthName(static_cast<int>(date.m)).data(), static_cast<long long>(date.y), secondOfDay / 3600, secondOfDay / 60 % 60, secondOfDay % 60);
+                return buffer;
+            }
+
+            std::string malformed(std::string valid)
+            {
+                switch(uniform(0, 4))
+                {
+                case 0: // damaged stamp
+                    valid[static_cast<std::size_t>(uniform(0, static_cast<int>(valid.size()) - 1))] = "x:,9 -"[uniform(0, 5)];
+                    return valid;
+                case 1:
+                    return "2014-10-07T10:10:05Z";
+                case 2:
+                    return "Dienstag, 7. Oktober 2014 10:10";
+                case 3:
+                    return valid.substr(0, static_cast<std::size_t>(uniform(0, static_cast<int>(valid.size()) - 1)));
+                default:
+                    return "";
+                }
+            }
+
+        private:
+            static int weekdayOf(int year, int month, int day)
+            {
+                // Sakamoto's method, 0 is Sunday
+                static const int offsets[] = { 0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4 };
+                if(month < 3)
+                    --year;
+                return (year + year / 4 - year / 100 + year / 400 + offsets[month - 1] + day) % 7;
+            }
+
+            std::mt19937 rng_;
+        };
+
+        Shape pickShape(Generator& generator, CorpusKind kind)
+        {
+            Shape shape;
+            switch(kind)
+            {
+            case CorpusKind::fixed:
+                shape.namedZone = generator.chance(50);
+                shape.gmtOnly = true;
+                break;
+            case CorpusKind::rss:
+                shape.twoDigitDay = generator.chance(50);
+                shape.namedZone = generator.chance(50);
+                break;
+            case CorpusKind::feed:
+                shape.namedZone = generator.chance(50);
+                shape.recentDates = true;
+                break;
+            case CorpusKind::rfc822:
+                shape.dayOfWeek = generator.chance(20);
+                shape.twoDigitDay = generator.chance(50);
+                shape.fourDigitYear = false;
+                shape.seconds = generator.chance(70);
+                shape.namedZone = generator.chance(70);
+                break;
+            case CorpusKind::zones:
+                shape.namedZone = generator.chance(70);
+                break;
+            case CorpusKind::mixed:
+                shape.dayOfWeek = generator.chance(50);
+                shape.twoDigitDay = generator.chance(50);
+                shape.fourDigitYear = generator.chance(50);
+                shape.seconds = generator.chance(80);
+                shape.namedZone = generator.chance(50);
+                shape.irregularSpace = generator.chance(10);
+                break;
+            case CorpusKind::http: // see httpStamp()
+            case CorpusKind::log: // see logStamp()
+                break;
+            }
+            return shape;
+        }
+    }
+
+    std::string_view corpusName(CorpusKind kind) noexcept
+    {
+        switch(kind)
+        {
+        case CorpusKind::fixed: return "fixed";
+        case CorpusKind::rss: return "rss";
+        case CorpusKind::rfc822: return "rfc822";
+        case CorpusKind::zones: return "zones";
+        case CorpusKind::mixed: return "mixed";
+        case CorpusKind::feed: return "feed";
+        case CorpusKind::http: return "http";
+        case CorpusKind::log: return "log";
+        }
+        return "unknown";
+    }
+
+    std::vector<std::string> makeCorpus(CorpusKind kind, std::size_t count, unsigned malformedPercent)
+    {
+        Generator generator{ 882 + static_cast<unsigned>(kind) };
+
+        std::vector<std::string> corpus;
+        corpus.reserve(count);
+        std::int64_t logSeconds = 10 * 3600;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            // The items of a polled feed are seen again on the next few polls
+            if(kind == CorpusKind::feed && !corpus.empty() && generator.chance(50))
+            {
+                const int recent = static_cast<int>(std::min<std::size_t>(corpus.size(), 100));
+                corpus.push_back(corpus[corpus.size() - static_cast<std::size_t>(generator.uniform(1, recent))]);
+                continue;
+            }
+
+            std::string stamp;
+            if(kind == CorpusKind::http)
+                stamp = generator.httpStamp();
+            else if(kind == CorpusKind::log)
+                stamp = generator.logStamp(logSeconds += generator.uniform(0, 9));
+            else
+                stamp = generator.stamp(pickShape(generator, kind));
+            if(generator.chance(malformedPercent))
+                stamp = generator.malformed(std::move(stamp));
+            corpus.push_back(std::move(stamp));
+        }
+        return corpus;
+    }
+
+    std::vector<std::string> loadCorpus(const std::string& path)
+    {
+        std::vector<std::string> corpus;
+        std::ifstream in{ path };
+        for(std::string line; std::getline(in, line);)
+        {
+            if(!line.empty() && line.back() == '\r')
+                line.pop_back();
+            corpus.push_back(std::move(line));
+        }
+        return corpus;
+    }
+}
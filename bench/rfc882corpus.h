@@ -0,0 +1,38 @@
+#ifndef RFC882CORPUS_H
+#define RFC882CORPUS_H
+
+/*
+Deterministic stamp corpora for the benchmarks.
+Every corpus is generated from a fixed seed, so results are comparable between runs and releases.
+*/
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rfc882::bench
+{
+    enum class CorpusKind
+    {
+        fixed,      // "Ddd, DD Mon YYYY HH:MM:SS +HHMM" and "Ddd, DD Mon YYYY HH:MM:SS GMT" only
+        rss,        // 4-digit years with day of week, any zone
+        rfc822,     // 2-digit years, mostly without day of week, optional seconds
+        zones,      // every named zone plus numeric differentials
+        mixed,      // all of the above shapes, plus irregular whitespace
+        feed,       // two weeks of dates, with half of the stamps repeating recent ones (as in polled feeds)
+        http,       // HTTP-dates: IMF-fixdate, with 5% each of the obsolete RFC 850 and asctime() forms (rfc882http.h)
+        log         // "Ddd, DD Mon YYYY HH:MM:SS +HHMM" in order, 0 - 9 seconds apart (as in log files)
+    };
+
+    std::string_view corpusName(CorpusKind kind) noexcept;
+
+    // Generate count stamps of the given kind. malformedPercent of them (0 - 100) are replaced by
+    // garbage: damaged stamps, ISO 8601 strings, localized dates and empty strings.
+    std::vector<std::string> makeCorpus(CorpusKind kind, std::size_t count, unsigned malformedPercent);
+
+    // Read one stamp per line. Returns an empty corpus if the file can't be read.
+    std::vector<std::string> loadCorpus(const std::string& path);
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+Differential driver: checks every parser engine against the std::regex reference (see rfc882differential.h)
+without a fuzzing engine, so it can run in CI with any compiler.
+
+    rfc882diff [--mutations=N] [--seed=N] [file or directory...]
+
+The engines are first checked on a table of stamps whose outcomes are known. The stamps are then, in order:
+
+    1. Every file given on the command line, and every file of the directories given (such as fuzz/corpus),
+       with one stamp per line.
+    2. The generated benchmark corpora, with 25% malformed stamps.
+    3. N random mutations (100000 by default) of the stamps of 1 and 2: bytes replaced, inserted, deleted
+       or duplicated, digits changed, and splices of two stamps.
+
+The stamps are checked in batches of 100. The first disagreement of each batch is printed, and the exit
+status is 1 if there was any.
+
+    g++ -O2 -std=c++17 fuzz/rfc882diff.cpp fuzz/rfc882differential.cpp bench/rfc882corpus.cpp rfc882*.cpp -o rfc882diff
+    ./rfc882diff fuzz/corpus
+*/
+
+#include <algorithm> // for std::min(), std::sort()
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib> // for std::strtoul()
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rfc882differential.h"
+#include "../bench/rfc882corpus.h"
+
+namespace
+{
+    // Stamps are checked in batches, so that parseBatch() and StreamParser see them side by side
+    constexpr std::size_t batchSize = 100;
+
+    // Bytes that the grammar gives a meaning to, so that mutations reach past the first token more often
+    using namespace std::string_view_literals;
+    constexpr std::string_view interestingBytes = "0123456789 \t\r\n,:+-ADEFGJMNOPSTUWYZadeghnopr\0\xFF"sv;
+
+    std::string mutate(std::string stamp, const std::vector<std::string>& stamps, std::mt19937& rng)
+    {
+        const auto uniform = [&rng](std::size_t low, std::size_t high) { return std::uniform_int_distribution<std::size_t>{ low, high }(rng); };
+        const auto randomByte = [&] { return interestingBytes[uniform(0, interestingBytes.size() - 1)]; };
+
+        for(std::size_t edits = uniform(1, 3); edits != 0; --edits)
+        {
+            const std::size_t at = uniform(0, stamp.size());
+            switch(uniform(0, 5))
+            {
+            case 0: // replace a byte
+                if(at < stamp.size())
+                    stamp[at] = randomByte();
+                break;
+            case 1: // insert a byte
+                stamp.insert(at, 1, randomByte());
+                break;
+            case 2: // delete a few bytes
+                stamp.erase(at, uniform(1, 3));
+                break;
+            case 3: // duplicate a few bytes
+                stamp.insert(at, stamp.substr(at, uniform(1, 4)));
+                break;
+            case 4: // change a digit, which mostly keeps the stamp valid but moves the date
+                if(at < stamp.size() && stamp[at] >= '0' && stamp[at] <= '9')
+                    stamp[at] = static_cast<char>('0' + uniform(0, 9));
+                break;
+            default: // the start of this stamp and the end of another one
+            {
+                const std::string& other = stamps[uniform(0, stamps.size() - 1)];
+                stamp = stamp.substr(0, at) + other.substr(std::min(at, other.size()));
+                break;
+            }
+            }
+        }
+        return stamp;
+    }
+
+    // Add the stamps of a file, or of every file of a directory. Returns false if path doesn't exist.
+    bool addStamps(const std::filesystem::path& path, std::vector<std::string>& stamps)
+    {
+        std::error_code error;
+        if(std::filesystem::is_directory(path, error))
+        {
+            // In name order, so that the mutations don't depend on the order of the directory
+            std::vector<std::filesystem::path> files;
+            for(const auto& entry : std::filesystem::directory_iterator{ path, error })
+            {
+                if(entry.is_regular_file(error))
+                    files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end());
+            for(const auto& file : files)
+                addStamps(file, stamps);
+            return !error;
+        }
+        if(!std::filesystem::exists(path, error))
+            return false;
+
+        const std::vector<std::string> file = rfc882::bench::loadCorpus(path.string());
+        stamps.insert(stamps.end(), file.begin(), file.end());
+        return true;
+    }
+
+    // Check the stamps in batches. Returns the number of disagreements.
+    std::size_t check(const std::vector<std::string>& stamps)
+    {
+        std::size_t mismatches = 0;
+        for(std::size_t begin = 0; begin < stamps.size(); begin += batchSize)
+        {
+            const std::vector<std::string_view> batch(stamps.begin() + begin, stamps.begin() + std::min(begin + batchSize, stamps.size()));
+            const std::string mismatch = rfc882::fuzz::checkStamps(batch.data(), batch.size());
+            if(!mismatch.empty())
+            {
+                std::printf("%s\n", mismatch.c_str());
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned long mutations = 100000;
+    unsigned long seed = 882;
+    std::vector<std::string> stamps;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if(arg.substr(0, 12) == "--mutations=")
+            mutations = std::strtoul(argv[i] + 12, nullptr, 10);
+        else if(arg.substr(0, 7) == "--seed=")
+            seed = std::strtoul(argv[i] + 7, nullptr, 10);
+        else if(!addStamps(argv[i], stamps))
+        {
+            std::fprintf(stderr, "rfc882diff: can't read %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    for(const auto kind : { rfc882::bench::CorpusKind::fixed, rfc882::bench::CorpusKind::rss, rfc882::bench::CorpusKind::rfc822,
+        rfc882::bench::CorpusKind::zones, rfc882::bench::CorpusKind::mixed, rfc882::bench::CorpusKind::feed, rfc882::bench::CorpusKind::http,
+        rfc882::bench::CorpusKind::log })
+    {
+        const std::vector<std::string> corpus = rfc882::bench::makeCorpus(kind, 2000, 25);
+        stamps.insert(stamps.end(), corpus.begin(), corpus.end());
+    }
+
+    std::mt19937 rng{ static_cast<std::mt19937::result_type>(seed) };
+    std::vector<std::string> mutants;
+    mutants.reserve(mutations);
+    for(unsigned long i = 0; i < mutations; ++i)
+        mutants.push_back(mutate(stamps[std::uniform_int_distribution<std::size_t>{ 0, stamps.size() - 1 }(rng)], stamps, rng));
+
+    // The known answers first, since the rest only compares the engines with the reference
+    const std::string known = rfc882::fuzz::checkKnownAnswers();
+    if(!known.empty())
+        std::printf("%s\n", known.c_str());
+
+    const std::size_t mismatches = (known.empty() ? 0 : 1) + check(stamps) + check(mutants);
+    std::printf("%zu stamps and %zu mutations checked, %zu disagreements\n", stamps.size(), mutants.size(), mismatches);
+    return mismatches ? 1 : 0;
+}
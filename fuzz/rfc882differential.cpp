@@ -0,0 +1,853 @@
+#include <algorithm> // for std::min(), std::find() and std::equal()
+#include <chrono>
+#include <cstdint>
+#include <cstdio> // for std::snprintf()
+#include <iterator> // for std::size()
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <type_traits> // for std::is_same_v
+#include <utility> // for std::pair
+#include <vector>
+
+#include "rfc882differential.h"
+#include "../rfc882cache.h"
+#include "../rfc882calendar.h"
+#include "../rfc882compact.h"
+#include "../rfc882datetime.h"
+#include "../rfc882find.h"
+#include "../rfc882format.h"
+#include "../rfc882http.h"
+#include "../rfc882inline.h"
+#include "../rfc882lazy.h"
+#include "../rfc882literal.h"
+#include "../rfc882parallel.h"
+#include "../rfc882parser.h"
+#include "../rfc882pipeline.h"
+#include "../rfc882pmr.h"
+#include "../rfc882prefilter.h"
+#include "../rfc882regex.h"
+#include "../rfc882scanner.h"
+#include "../rfc882sequential.h"
+#include "../rfc882simd.h"
+#include "../rfc882stream.h"
+#include "../rfc882tables.h"
+
+namespace rfc882::fuzz
+{
+    namespace
+    {
+        constexpr const char* tokenNames[] = { "dayOfWeek", "day", "month", "year", "hour", "minute", "second", "timeZone" };
+
+        using TokenTexts = std::vector<std::string>;
+
+        // What an engine made of a stamp. The fields that an engine doesn't report are left empty.
+        struct Outcome
+        {
+            bool accepted = false;
+            std::chrono::system_clock::time_point time{};
+            std::optional<RFC882DateTime::DateTime> dateTime;
+            std::optional<std::chrono::minutes> timeZoneDifferential;
+            TokenTexts tokens;              // One per token name
+        };
+
+        // For the tokens of RFC882DateTime and of pmr::RFC882DateTime
+        template <class Tokens>
+        TokenTexts tokenTexts(const Tokens& tokens)
+        {
+            return { std::string{ tokens.dayOfWeek }, std::string{ tokens.day }, std::string{ tokens.month }, std::string{ tokens.year },
+                std::string{ tokens.hour }, std::string{ tokens.minute }, std::string{ tokens.second }, std::string{ tokens.timeZone } };
+        }
+
+        TokenTexts tokenTexts(std::string_view stamp, const ParseResult::Tokens& tokens)
+        {
+            return { std::string{ token(stamp, tokens.dayOfWeek) }, std::string{ token(stamp, tokens.day) },
+                std::string{ token(stamp, tokens.month) }, std::string{ token(stamp, tokens.year) },
+                std::string{ token(stamp, tokens.hour) }, std::string{ token(stamp, tokens.minute) },
+                std::string{ token(stamp, tokens.second) }, std::string{ token(stamp, tokens.timeZone) } };
+        }
+
+        Outcome outcome(std::string_view stamp, const ParseResult& result)
+        {
+            Outcome out;
+            if(!result)
+                return out;
+            out.accepted = true;
+            out.time = result.time;
+            out.dateTime = result.dateTime;
+            out.tokens = tokenTexts(stamp, result.tokens);
+            return out;
+        }
+
+        // For RFC882DateTime and pmr::RFC882DateTime
+        template <class Date>
+        Outcome outcome(const std::optional<Date>& date)
+        {
+            Outcome out;
+            if(!date)
+                return out;
+            out.accepted = true;
+            out.time = date->time;
+            out.dateTime = date->dateTime;
+            out.tokens = tokenTexts(date->tokens);
+            return out;
+        }
+
+        Outcome outcome(const std::optional<LazyDateTime>& date)
+        {
+            Outcome out;
+            if(!date)
+                return out;
+            out.accepted = true;
+            out.time = date->time();
+            out.dateTime = date->dateTime();
+            out.tokens = tokenTexts(date->tokens());
+            return out;
+        }
+
+        // The stamp in double quotes, with the bytes that aren't printable ASCII as \xHH
+        std::string quote(std::string_view stamp)
+        {
+            std::string quoted = "\"";
+            for(const char c : stamp)
+            {
+                if(c >= ' ' && c <= '~' && c != '"' && c != '\\')
+                {
+                    quoted += c;
+                    continue;
+                }
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\x%02X", static_cast<unsigned char>(c));
+                quoted += escape;
+            }
+            return quoted += '"';
+        }
+
+        std::string describe(const RFC882DateTime::DateTime& date)
+        {
+            char text[96];
+            std::snprintf(text, sizeof(text), "%d-%02d-%02d %02d:%02d:%02d %+d min", date.year, date.month, date.day,
+                date.hour, date.minute, date.second, static_cast<int>(date.timeZoneDifferential.count()));
+            return text;
+        }
+
+        bool sameDateTime(const RFC882DateTime::DateTime& x, const RFC882DateTime::DateTime& y) noexcept
+        {
+            return x.day == y.day && x.month == y.month && x.year == y.year && x.hour == y.hour &&
+                x.minute == y.minute && x.second == y.second && x.timeZoneDifferential == y.timeZoneDifferential;
+        }
+
+        // An empty string if the outcome of engine on stamp is the expected one, that of source
+        std::string compare(const char* engine, std::string_view stamp, const Outcome& expected, const Outcome& actual,
+            const char* source = "the reference")
+        {
+            const std::string where = std::string{ engine } + ": " + quote(stamp);
+            if(actual.accepted != expected.accepted)
+                return where + (actual.accepted ? " is accepted, " : " is rejected, ") + source + (actual.accepted ? " rejects it" : " accepts it");
+            if(!actual.accepted)
+                return {};
+
+            if(actual.time != expected.time)
+            {
+                return where + " is at " + std::to_string(actual.time.time_since_epoch().count()) + " instead of " +
+                    std::to_string(expected.time.time_since_epoch().count()) + " (system_clock ticks)";
+            }
+            if(actual.dateTime && !sameDateTime(*actual.dateTime, *expected.dateTime))
+                return where + " is " + describe(*actual.dateTime) + " instead of " + describe(*expected.dateTime);
+            if(actual.timeZoneDifferential && *actual.timeZoneDifferential != expected.dateTime->timeZoneDifferential)
+            {
+                return where + " has a differential of " + std::to_string(actual.timeZoneDifferential->count()) + " instead of " +
+                    std::to_string(expected.dateTime->timeZoneDifferential.count()) + " min";
+            }
+            if(!actual.tokens.empty())
+            {
+                for(std::size_t i = 0; i < std::size(tokenNames); ++i)
+                {
+                    if(actual.tokens[i] != expected.tokens[i])
+                        return where + " has the " + tokenNames[i] + " token " + quote(actual.tokens[i]) + " instead of " + quote(expected.tokens[i]);
+                }
+            }
+            return {};
+        }
+
+        // A stamp whose outcome is known, so that a bug that the reference shares with the engines is still found
+        struct KnownAnswer
+        {
+            const char* stamp;
+            bool accepted;
+            std::int64_t seconds;       // UTC seconds since the epoch, if accepted
+        };
+
+        // The last day of February was rejected before the calendar became table-driven
+        constexpr KnownAnswer knownAnswers[] = {
+            { "Sat, 28 Feb 2015 10:00:00 GMT", true, 1425117600 },
+            { "Mon, 29 Feb 2016 10:00:00 GMT", true, 1456740000 },
+            { "Tue, 29 Feb 2000 00:00:00 GMT", true, 951782400 },
+            { "Sun, 28 Feb 2100 23:59:59 GMT", true, 4107542399 },
+            { "Wed, 28 Feb 1900 12:00:00 GMT", true, -2203934400 },
+            { "1 Mar 2016 00:00 GMT", true, 1456790400 },
+            { "29 Feb 2015 10:00:00 GMT", false, 0 },
+            { "29 Feb 1900 12:00:00 GMT", false, 0 },
+            { "29 Feb 2100 12:00:00 GMT", false, 0 },
+            { "30 Feb 2016 00:00 GMT", false, 0 },
+            { "31 Apr 2015 00:00 GMT", false, 0 },
+        };
+
+        // Stamps and what format() writes for them. Differentials beyond +/-99:59 are clamped to it.
+        constexpr std::pair<const char*, const char*> knownFormats[] = {
+            { "7 Oct 14 10:10:05 PST", "Tue, 07 Oct 2014 10:10:05 -0800" },
+            { "Tue, 07 Oct 2014 10:10:05 +9959", "Tue, 07 Oct 2014 10:10:05 +9959" },
+            { "Tue, 07 Oct 2014 10:10:05 +9999", "Tue, 07 Oct 2014 09:30:05 +9959" },
+            { "Tue, 07 Oct 2014 10:10:05 -9999", "Tue, 07 Oct 2014 10:50:05 -9959" },
+        };
+
+        // The years of Rfc5322Dialect, which dialectOutcome() takes from the dialect itself
+        constexpr std::pair<const char*, int> knownRfc5322Years[] = {
+            { "7 Oct 49 10:10 GMT", 2049 },
+            { "7 Oct 50 10:10 GMT", 1950 },
+            { "7 Oct 114 10:10 GMT", 2014 },
+            { "7 Oct 2014 10:10 GMT", 2014 },
+        };
+
+        // Only the accept/reject decision and the time, for comparing with a KnownAnswer
+        Outcome timeOnly(Outcome out)
+        {
+            out.dateTime.reset();
+            out.timeZoneDifferential.reset();
+            out.tokens.clear();
+            return out;
+        }
+
+        // The stamps that parse<StrictWeekday>() accepts: those of the reference whose day of week, if any, is right
+        Outcome strictOutcome(const Outcome& reference)
+        {
+            if(!reference.accepted || reference.tokens[0].empty())
+                return reference;
+
+            const RFC882DateTime::DateTime& date = *reference.dateTime;
+            const std::int64_t days = days_from_civil<std::int64_t>(date.year, static_cast<unsigned>(date.month), static_cast<unsigned>(date.day));
+            if(weekdayFromName(reference.tokens[0]) == static_cast<int>(weekday_from_days(days)))
+                return reference;
+            return {};
+        }
+
+        // Whether the reference took stamp as an IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT"), which HTTP parses the same way.
+        // yearBelow100 is set for the years 0000 - 0099, which the reference moves to 2000+ and HTTP doesn't.
+        bool isImfFixdate(std::string_view stamp, const Outcome& reference, bool& yearBelow100)
+        {
+            if(!reference.accepted || stamp.size() != 29)
+                return false;
+            const TokenTexts& tokens = reference.tokens;
+            if(tokens[0].size() != 3 || tokens[1].size() != 2 || tokens[3].size() != 4 || tokens[6].size() != 2 || tokens[7] != "GMT")
+                return false;
+            yearBelow100 = tokens[3].compare("0100") < 0;
+            return stamp[3] == ',' && stamp[4] == ' ' && stamp[7] == ' ' && stamp[11] == ' ' && stamp[16] == ' ' && stamp[25] == ' ';
+        }
+
+        // The now of parseHttpDate(), so that RFC 850 years don't depend on the day of the run: 1 June 2026, when the
+        // 2-digit years up to 76 are 20xx and the other ones 19xx
+        constexpr std::chrono::system_clock::time_point httpNow{ std::chrono::seconds{ 1780272000 } };
+
+        constexpr std::string_view shortWeekdayNames[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+        constexpr std::string_view longWeekdayNames[] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+        constexpr std::string_view monthNames[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+        template <std::size_t N>
+        bool isOneOf(std::string_view name, const std::string_view (&names)[N])
+        {
+            return std::find(std::begin(names), std::end(names), name) != std::end(names);
+        }
+
+        // Whether text has the shape of pattern, where '9' is a digit, '_' a digit or a space, 'a' any byte
+        // and every other byte itself
+        bool fits(std::string_view text, std::string_view pattern) noexcept
+        {
+            if(text.size() != pattern.size())
+                return false;
+            for(std::size_t i = 0; i < text.size(); ++i)
+            {
+                const bool digit = text[i] >= '0' && text[i] <= '9';
+                const bool fit = (pattern[i] == '9') ? digit : (pattern[i] == '_') ? digit || text[i] == ' ' :
+                    pattern[i] == 'a' || text[i] == pattern[i];
+                if(!fit)
+                    return false;
+            }
+            return true;
+        }
+
+        // What parseHttpDate() must make of stamp. IMF-fixdates are what the reference makes of them, and the obsolete forms
+        // what it makes of their date written as "DD Mon YYYY HH:MM:SS GMT", without the tokens, which are those of another
+        // stamp. Returns false for the years 0000 - 0099, which the reference moves to 2000+ and HTTP doesn't.
+        bool httpOutcome(std::string_view stamp, const Outcome& reference, Outcome& expected)
+        {
+            bool yearBelow100 = false;
+            if(isImfFixdate(stamp, reference, yearBelow100))
+            {
+                expected = reference;
+                return !yearBelow100;
+            }
+
+            // asctime(): "Sun Nov  6 08:49:37 1994"
+            std::string date;
+            const std::size_t comma = stamp.find(',');
+            if(stamp.size() > 3 && isOneOf(stamp.substr(0, 3), shortWeekdayNames) && fits(stamp.substr(3), " aaa _9 99:99:99 9999") &&
+                isOneOf(stamp.substr(4, 3), monthNames))
+            {
+                if(stamp.substr(20) < "0100")
+                    return false;
+                const std::string_view day = (stamp[8] == ' ') ? stamp.substr(9, 1) : stamp.substr(8, 2);
+                date.append(day).append(" ").append(stamp.substr(4, 3)).append(" ").append(stamp.substr(20, 4)).append(" ")
+                    .append(stamp.substr(11, 8)).append(" GMT");
+            }
+            // RFC 850: "Sunday, 06-Nov-94 08:49:37 GMT"
+            else if(comma != std::string_view::npos && isOneOf(stamp.substr(0, comma), longWeekdayNames) &&
+                fits(stamp.substr(comma), ", 99-aaa-99 99:99:99 GMT") && isOneOf(stamp.substr(comma + 5, 3), monthNames))
+            {
+                const int year = (stamp[comma + 9] - '0') * 10 + (stamp[comma + 10] - '0');
+                date.append(stamp.substr(comma + 2, 2)).append(" ").append(stamp.substr(comma + 5, 3)).append(" ")
+                    .append(std::to_string(year > 76 ? 1900 + year : 2000 + year)).append(" ").append(stamp.substr(comma + 12, 8)).append(" GMT");
+            }
+            else
+            {
+                expected = {};
+                return true;
+            }
+
+            expected = outcome(parseDateAndTimeSpecRegex(date));
+            expected.tokens.clear();
+            return true;
+        }
+
+        // ASCII, for the names that case-insensitive dialects take
+        std::string titleCase(std::string_view name)
+        {
+            std::string text{ name };
+            for(std::size_t i = 0; i < text.size(); ++i)
+            {
+                if(i == 0 && text[i] >= 'a' && text[i] <= 'z')
+                    text[i] = static_cast<char>(text[i] - 'a' + 'A');
+                else if(i != 0 && text[i] >= 'A' && text[i] <= 'Z')
+                    text[i] = static_cast<char>(text[i] - 'A' + 'a');
+            }
+            return text;
+        }
+
+        // What BasicParser<Dialect> must make of stamp, for the dialects of rfc882parser.h: what the reference makes of it,
+        // unless its year has fewer or more digits than the dialect takes, the dialect expands the year otherwise or the
+        // day of week must be that of the date. The stamps that the reference rejects are rejected by the dialects that
+        // take nothing more than it does. std::nullopt where that can't be told: for the years that the dialect leaves
+        // below 100, and for the other stamps that the reference rejects.
+        template <class Dialect>
+        std::optional<Outcome> dialectOutcome(std::string_view stamp, const Outcome& reference)
+        {
+            constexpr bool referenceGrammar = !Dialect::caseInsensitive && Dialect::whitespace == Whitespace::runs &&
+                std::is_same_v<typename Dialect::Zones, ReferenceZones> && Dialect::minYearDigits >= 2 && Dialect::maxYearDigits <= 4;
+            if(!reference.accepted)
+                return referenceGrammar ? std::optional<Outcome>{ Outcome{} } : std::nullopt;
+
+            const std::string& year = reference.tokens[3];
+            if(year.size() < Dialect::minYearDigits || year.size() > Dialect::maxYearDigits)
+                return Outcome{};
+
+            int written = 0;
+            for(const char digit : year)
+                written = written * 10 + (digit - '0');
+            const int expanded = Dialect::expandYear(written, year.size());
+
+            Outcome expected = reference;
+            if(expanded != reference.dateTime->year)
+            {
+                if(expanded < 100)
+                    return std::nullopt;
+
+                // The same stamp with the year as the dialect takes it, which the reference takes as it is
+                const TokenSpan span = parse(stamp).tokens.year;
+                std::string rewritten{ stamp };
+                rewritten.replace(span.offset, span.length, std::to_string(expanded));
+                expected = outcome(parseDateAndTimeSpecRegex(rewritten));
+            }
+            if constexpr(Dialect::checkWeekday)
+                expected = strictOutcome(expected);
+            if(!expected.tokens.empty())
+                expected.tokens[3] = year;
+            return expected;
+        }
+
+        // The stamp in the grammar of the reference for what a dialect parsed: its tokens, with the names in the case of the
+        // tables, the year as the dialect expanded it and the zone as a numeric differential. std::nullopt for the years that
+        // the dialect leaves below 100 and the differentials beyond +/-99:59, which can't be written so.
+        std::optional<std::string> referenceStamp(std::string_view stamp, const ParseResult& result)
+        {
+            const RFC882DateTime::DateTime& date = result.dateTime;
+            const int differential = static_cast<int>(date.timeZoneDifferential.count());
+            const int maxDifferential = static_cast<int>(maxFormattedDifferential.count());
+            if(date.year < 100 || differential < -maxDifferential || differential > maxDifferential)
+                return std::nullopt;
+
+            std::string text;
+            if(result.tokens.dayOfWeek.length != 0)
+                text.append(titleCase(token(stamp, result.tokens.dayOfWeek))).append(", ");
+            text.append(token(stamp, result.tokens.day)).append(" ").append(titleCase(token(stamp, result.tokens.month))).append(" ");
+
+            char fields[16];
+            std::snprintf(fields, sizeof(fields), "%04d ", date.year);
+            text.append(fields).append(token(stamp, result.tokens.hour)).append(":").append(token(stamp, result.tokens.minute));
+            if(result.tokens.second.length != 0)
+                text.append(":").append(token(stamp, result.tokens.second));
+
+            const int minutes = differential < 0 ? -differential : differential;
+            std::snprintf(fields, sizeof(fields), " %c%02d%02d", differential < 0 ? '-' : '+', minutes / 60, minutes % 60);
+            return text.append(fields);
+        }
+
+        // BasicParser<Dialect> against dialectOutcome(), or else, for the stamps that it accepts, against what the reference
+        // makes of their referenceStamp()
+        template <class Dialect>
+        std::string checkDialect(const char* engine, std::string_view stamp, const Outcome& reference)
+        {
+            const ParseResult result = BasicParser<Dialect>::parse(stamp);
+            if(const std::optional<Outcome> expected = dialectOutcome<Dialect>(stamp, reference))
+                return compare(engine, stamp, *expected, outcome(stamp, result));
+
+            const std::optional<std::string> rewritten = result ? referenceStamp(stamp, result) : std::nullopt;
+            if(!rewritten)
+                return {};
+
+            Outcome expected = outcome(parseDateAndTimeSpecRegex(*rewritten));
+            if constexpr(Dialect::checkWeekday)
+                expected = strictOutcome(expected);
+            expected.tokens.clear();
+            Outcome actual = outcome(stamp, result);
+            actual.tokens.clear();
+            return compare(engine, stamp, expected, actual, ("the reference on " + quote(*rewritten)).c_str());
+        }
+
+        // format() of the parsed stamp must parse back to the same time, and to the same differential unless that
+        // was clamped. Only for the years whose times fit in system_clock, as format() requires.
+        std::string checkFormat(std::string_view stamp, const Outcome& reference)
+        {
+            if(!reference.accepted || reference.dateTime->year < 1678 || reference.dateTime->year > 2261)
+                return {};
+
+            char formatted[formattedSize];
+            const std::optional<RFC882DateTime> date = parseDateAndTimeSpec(std::string{ stamp });
+            const std::string_view stampOut{ formatted, static_cast<std::size_t>(format(*date, formatted) - formatted) };
+            const ParseResult parsed = parse(stampOut);
+
+            Outcome actual;
+            actual.accepted = parsed.valid;
+            actual.time = parsed.time;
+            const std::chrono::minutes differential = reference.dateTime->timeZoneDifferential;
+            if(differential >= -maxFormattedDifferential && differential <= maxFormattedDifferential)
+                actual.timeZoneDifferential = parsed.dateTime.timeZoneDifferential;
+            return compare("format()", stamp, reference, actual);
+        }
+
+        // The same for formatAsParsed() of the CompactDateTime, through toDateTime()
+        std::string checkCompact(std::string_view stamp, const Outcome& reference)
+        {
+            if(!reference.accepted || reference.dateTime->year < 1678 || reference.dateTime->year > 2261)
+                return {};
+
+            const std::optional<RFC882DateTime> date = toDateTime(compact(stamp, parse(stamp)));
+            Outcome actual;
+            actual.accepted = date.has_value();
+            if(date)
+                actual.time = date->time;
+            return compare("toDateTime(CompactDateTime)", stamp, reference, actual);
+        }
+
+        std::string checkStamp(std::string_view stamp, const Outcome& reference)
+        {
+            std::string mismatch;
+            const auto check = [&](const char* engine, const Outcome& expected, const Outcome& actual) {
+                if(mismatch.empty())
+                    mismatch = compare(engine, stamp, expected, actual);
+            };
+
+            check("parse()", reference, outcome(stamp, parse(stamp)));
+            check("parse<StrictWeekday>()", strictOutcome(reference), outcome(stamp, parse<StrictWeekday>(stamp)));
+            check("parseDateAndTimeSpec()", reference, outcome(parseDateAndTimeSpec(std::string{ stamp })));
+            check("parseDateAndTimeSpecLazy()", reference, outcome(parseDateAndTimeSpecLazy(std::string{ stamp })));
+
+            std::pmr::monotonic_buffer_resource arena;
+            check("parseDateAndTimeSpec() on an arena", reference, outcome(parseDateAndTimeSpec(stamp, &arena)));
+
+            // The first call may miss the cache and the second one hits it
+            check("parseCached()", reference, outcome(stamp, parseCached(stamp)));
+            check("parseCached() again", reference, outcome(stamp, parseCached(stamp)));
+
+            check("parseConstexpr()", reference, outcome(stamp, parseConstexpr(stamp)));
+            check("parseInline()", reference, outcome(stamp, parseInline(stamp)));
+            check("BasicParser<ReferenceDialect>", reference, outcome(stamp, BasicParser<ReferenceDialect>::parse(stamp)));
+
+            bool yearBelow100 = false;
+            const Outcome imfFixdate = isImfFixdate(stamp, reference, yearBelow100) ? reference : Outcome{};
+            if(!yearBelow100)
+                check("parseImfFixdate()", imfFixdate, outcome(stamp, parseImfFixdate(stamp)));
+
+            Outcome httpDate;
+            if(httpOutcome(stamp, reference, httpDate))
+            {
+                Outcome actual = outcome(stamp, parseHttpDate(stamp, httpNow));
+                if(httpDate.tokens.empty())
+                    actual.tokens.clear();
+                check("parseHttpDate()", httpDate, actual);
+            }
+
+            if(mismatch.empty())
+                mismatch = checkDialect<Rfc822Dialect>("Rfc822Parser", stamp, reference);
+            if(mismatch.empty())
+                mismatch = checkDialect<Rfc5322Dialect>("Rfc5322Parser", stamp, reference);
+            if(mismatch.empty())
+                mismatch = checkDialect<RssDialect>("RssParser", stamp, reference);
+            if(mismatch.empty())
+                mismatch = checkDialect<LenientDialect>("LenientParser", stamp, reference);
+            if(mismatch.empty())
+                mismatch = checkDialect<ExtendedDialect>("ExtendedParser", stamp, reference);
+            if(mismatch.empty())
+                mismatch = checkFormat(stamp, reference);
+            if(mismatch.empty())
+                mismatch = checkCompact(stamp, reference);
+            if(mismatch.empty() && reference.accepted && prefilter(stamp) != RejectReason::none)
+                mismatch = "prefilter(): " + quote(stamp) + " is rejected, the reference accepts it";
+            return mismatch;
+        }
+
+        // parse(stamps, count, out) is parseBatch() or parseBatchParallel(). stamps may repeat the stamps of reference.
+        template <class Parse>
+        std::string checkBatch(const char* engine, const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference, Parse&& parse)
+        {
+            const auto time = std::make_unique<std::chrono::system_clock::time_point[]>(count);
+            const auto differential = std::make_unique<std::int16_t[]>(count);
+            const auto valid = std::make_unique<std::uint8_t[]>((count + 7) / 8);
+            const std::size_t parsed = parse(stamps, count, BatchOutput{ time.get(), differential.get(), valid.get() });
+
+            std::size_t accepted = 0;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                Outcome actual;
+                actual.accepted = (valid[i / 8] >> (i % 8)) & 1;
+                actual.time = time[i];
+                actual.timeZoneDifferential = std::chrono::minutes{ differential[i] };
+                accepted += actual.accepted;
+
+                std::string mismatch = compare(engine, stamps[i], reference[i % reference.size()], actual);
+                if(!mismatch.empty())
+                    return mismatch;
+            }
+            if(parsed != accepted)
+                return std::string{ engine } + ": returns " + std::to_string(parsed) + " but sets " + std::to_string(accepted) + " bits";
+            return {};
+        }
+
+        std::string checkBatch(const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference)
+        {
+            return checkBatch("parseBatch()", stamps, count, reference,
+                [](const std::string_view* batch, std::size_t size, const BatchOutput& out) { return parseBatch(batch, size, out); });
+        }
+
+        // parseBatchParallel() over as many copies of the stamps as make 4 chunks, on 3 threads
+        std::string checkParallel(const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference)
+        {
+            if(count == 0)
+                return {};
+
+            std::vector<std::string_view> copies;
+            while(copies.size() < 4 * parallelChunkGranularity)
+                copies.insert(copies.end(), stamps, stamps + count);
+
+            ParallelOptions options;
+            options.threads = 3;
+            options.chunkSize = parallelChunkGranularity;
+            return checkBatch("parseBatchParallel()", copies.data(), copies.size(), reference,
+                [&](const std::string_view* batch, std::size_t size, const BatchOutput& out) { return parseBatchParallel(batch, size, out, options); });
+        }
+
+        // The stamps that the reference accepts, each on a header line of one text, must be found by findAll() in order, with
+        // the results of the reference. The whitespace that the reference takes before a stamp isn't part of what is found.
+        std::string checkFind(const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference)
+        {
+            std::string text;
+            std::vector<std::size_t> accepted;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(reference[i].accepted)
+                {
+                    text.append("Date: ").append(stamps[i]).append("\r\n");
+                    accepted.push_back(i);
+                }
+            }
+
+            std::size_t next = 0;
+            std::string mismatch;
+            findAll(text, [&](const FoundStamp& found) {
+                if(next < accepted.size() && mismatch.empty())
+                {
+                    const std::size_t i = accepted[next];
+                    mismatch = compare("findAll()", stamps[i], reference[i], outcome(found.stamp, found.result));
+                }
+                ++next;
+            });
+
+            if(mismatch.empty() && next != accepted.size())
+                mismatch = "findAll(): finds " + std::to_string(next) + " stamps out of " + std::to_string(accepted.size());
+            return mismatch;
+        }
+
+        // Every fixed-layout and calendar kernel that the CPU supports, called directly so that those the dispatch didn't
+        // pick are checked too, against the scalar ones: on the stamps of the fixed-layout sizes, and on the dates that the
+        // scanner reads from the stamps, valid or not.
+        std::string checkKernels(const std::string_view* stamps, std::size_t count)
+        {
+            std::vector<std::pair<const char*, detail::FixedLayoutKernel>> fixedLayoutKernels;
+            std::vector<std::pair<const char*, detail::DateTimeKernel>> dateTimeKernels;
+#ifdef RFC882_SIMD_X86
+            if(detail::cpuSupportsSSSE3())
+                fixedLayoutKernels.emplace_back("fixedLayoutSSSE3()", detail::fixedLayoutSSSE3);
+            if(detail::cpuSupportsAVX2())
+            {
+                fixedLayoutKernels.emplace_back("fixedLayoutAVX2()", detail::fixedLayoutAVX2);
+                dateTimeKernels.emplace_back("convertDateTimesAVX2()", detail::convertDateTimesAVX2);
+            }
+#endif
+#ifdef RFC882_SIMD_AVX512
+            if(detail::cpuSupportsAVX512())
+                dateTimeKernels.emplace_back("convertDateTimesAVX512()", detail::convertDateTimesAVX512);
+#endif
+#ifdef RFC882_SIMD_NEON
+            fixedLayoutKernels.emplace_back("fixedLayoutNEON()", detail::fixedLayoutNEON);
+#endif
+
+            std::vector<RFC882DateTime::DateTime> dates;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const std::string_view stamp = stamps[i];
+                ParseResult scanned;
+                if(detail::scanDateAndTimeSpec(stamp, scanned))
+                    dates.push_back(scanned.dateTime);
+
+                const bool numericZone = stamp.size() == detail::fixedLayoutNumericSize;
+                if(!numericZone && stamp.size() != detail::fixedLayoutNamedSize)
+                    continue;
+
+                std::uint8_t expected[8];
+                const bool expectedFit = detail::fixedLayoutScalar(stamp.data(), numericZone, expected);
+                for(const auto& [name, kernel] : fixedLayoutKernels)
+                {
+                    std::uint8_t pairs[8];
+                    const bool fit = kernel(stamp.data(), numericZone, pairs);
+                    if(fit != expectedFit)
+                        return std::string{ name } + ": " + quote(stamp) + (fit ? " fits" : " doesn't fit") + ", fixedLayoutScalar() says otherwise";
+                    if(fit && !std::equal(pairs, pairs + (numericZone ? 8 : 6), expected))
+                        return std::string{ name } + ": " + quote(stamp) + " has other digit pairs than with fixedLayoutScalar()";
+                }
+            }
+
+            std::vector<std::chrono::system_clock::time_point> expectedTime(dates.size()), time(dates.size());
+            std::vector<std::uint8_t> expectedValid(dates.size()), valid(dates.size());
+            const std::size_t expectedCount = detail::convertDateTimesScalar(dates.data(), dates.size(), expectedTime.data(), expectedValid.data());
+            for(const auto& [name, kernel] : dateTimeKernels)
+            {
+                const std::size_t validCount = kernel(dates.data(), dates.size(), time.data(), valid.data());
+                for(std::size_t i = 0; i < dates.size(); ++i)
+                {
+                    if(valid[i] != expectedValid[i])
+                        return std::string{ name } + ": " + describe(dates[i]) + (valid[i] ? " is valid" : " is invalid") + ", convertDateTimesScalar() says otherwise";
+                    if(time[i] != expectedTime[i])
+                    {
+                        return std::string{ name } + ": " + describe(dates[i]) + " is at " + std::to_string(time[i].time_since_epoch().count()) +
+                            " instead of " + std::to_string(expectedTime[i].time_since_epoch().count()) + " (system_clock ticks)";
+                    }
+                }
+                if(validCount != expectedCount)
+                    return std::string{ name } + ": returns " + std::to_string(validCount) + " instead of " + std::to_string(expectedCount);
+            }
+            return {};
+        }
+
+        // The stamps as a stream in chunks of 1 to 16 bytes, through a ParsePipeline with small batches so that
+        // they end both at batch and at chunk boundaries. Stamps that contain '\n' are left out, as in checkStream().
+        std::string checkPipeline(const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference)
+        {
+            std::string stream;
+            std::vector<std::size_t> fed;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(stamps[i].find('\n') == std::string_view::npos)
+                {
+                    stream.append(stamps[i]) += '\n';
+                    fed.push_back(i);
+                }
+            }
+
+            std::size_t next = 0;
+            std::string mismatch;
+            const auto onBatch = [&](const ParsedBatch& batch) {
+                for(std::size_t j = 0; j < batch.count; ++j, ++next)
+                {
+                    if(next >= fed.size() || !mismatch.empty())
+                        continue;
+                    Outcome actual;
+                    actual.accepted = batch.isValid(j);
+                    actual.time = batch.time[j];
+                    actual.timeZoneDifferential = std::chrono::minutes{ batch.timeZoneDifferential[j] };
+                    const std::size_t i = fed[next];
+                    if(batch.stamps[j] != stamps[i])
+                        mismatch = "ParsePipeline: reports " + quote(batch.stamps[j]) + " for " + quote(stamps[i]);
+                    else
+                        mismatch = compare("ParsePipeline", stamps[i], reference[i], actual);
+                }
+            };
+
+            ParsePipeline pipeline{ 7 };
+            std::string_view rest = stream;
+            for(std::size_t chunk = 1; !rest.empty(); chunk = chunk % 16 + 1)
+            {
+                const std::size_t size = std::min(chunk, rest.size());
+                pipeline.feed(rest.substr(0, size), onBatch);
+                rest.remove_prefix(size);
+            }
+            pipeline.finish(onBatch);
+
+            if(mismatch.empty() && next != fed.size())
+                mismatch = "ParsePipeline: reports " + std::to_string(next) + " stamps out of " + std::to_string(fed.size());
+            return mismatch;
+        }
+
+        // One SequentialParser over the stamps in order, so that each one is checked against the one before
+        std::string checkSequential(const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference)
+        {
+            SequentialParser parser;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                std::string mismatch = compare("SequentialParser", stamps[i], reference[i], outcome(stamps[i], parser.parse(stamps[i])));
+                if(!mismatch.empty())
+                    return mismatch;
+            }
+            return {};
+        }
+
+        // Feed the stamps, each followed by the delimiter, in chunks of 1 to maxChunk bytes (all at once if 0).
+        // Stamps that contain the delimiter are left out, since it would split them.
+        std::string checkStream(const std::string_view* stamps, std::size_t count, const std::vector<Outcome>& reference, std::size_t maxChunk)
+        {
+            std::string stream;
+            std::vector<std::size_t> fed;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(stamps[i].find('\n') == std::string_view::npos)
+                {
+                    stream.append(stamps[i]) += '\n';
+                    fed.push_back(i);
+                }
+            }
+
+            std::size_t next = 0;
+            std::string mismatch;
+            const auto onStamp = [&](const ParseResult& result) {
+                if(next < fed.size() && mismatch.empty())
+                {
+                    const std::size_t i = fed[next];
+                    mismatch = compare(maxChunk ? "StreamParser in small chunks" : "StreamParser", stamps[i], reference[i], outcome(stamps[i], result));
+                }
+                ++next;
+            };
+
+            StreamParser parser;
+            std::string_view rest = stream;
+            for(std::size_t chunk = 1; !rest.empty(); chunk = maxChunk ? chunk % maxChunk + 1 : rest.size())
+            {
+                const std::size_t size = maxChunk ? std::min(chunk, rest.size()) : rest.size();
+                parser.feed(rest.substr(0, size), onStamp);
+                rest.remove_prefix(size);
+            }
+            parser.finish(onStamp);
+
+            if(mismatch.empty() && next != fed.size())
+                mismatch = "StreamParser: reports " + std::to_string(next) + " stamps out of " + std::to_string(fed.size());
+            return mismatch;
+        }
+    }
+
+    std::string checkStamps(const std::string_view* stamps, std::size_t count)
+    {
+        std::vector<Outcome> reference;
+        reference.reserve(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            reference.push_back(outcome(parseDateAndTimeSpecRegex(std::string{ stamps[i] })));
+            std::string mismatch = checkStamp(stamps[i], reference.back());
+            if(!mismatch.empty())
+                return mismatch;
+        }
+
+        std::string mismatch = checkBatch(stamps, count, reference);
+        if(mismatch.empty())
+            mismatch = checkParallel(stamps, count, reference);
+        if(mismatch.empty())
+            mismatch = checkFind(stamps, count, reference);
+        if(mismatch.empty())
+            mismatch = checkKernels(stamps, count);
+        if(mismatch.empty())
+            mismatch = checkSequential(stamps, count, reference);
+        if(mismatch.empty())
+            mismatch = checkPipeline(stamps, count, reference);
+        if(mismatch.empty())
+            mismatch = checkStream(stamps, count, reference, 0);
+        if(mismatch.empty())
+            mismatch = checkStream(stamps, count, reference, 16);
+        return mismatch;
+    }
+
+    std::string checkKnownAnswers()
+    {
+        std::vector<std::string_view> stamps;
+        for(const KnownAnswer& known : knownAnswers)
+        {
+            Outcome expected;
+            expected.accepted = known.accepted;
+            expected.time = std::chrono::system_clock::time_point{ std::chrono::seconds{ known.seconds } };
+
+            std::string mismatch = compare("The reference", known.stamp, expected,
+                timeOnly(outcome(parseDateAndTimeSpecRegex(known.stamp))), "the known answer");
+            if(mismatch.empty())
+                mismatch = compare("parse()", known.stamp, expected, timeOnly(outcome(known.stamp, parse(known.stamp))), "the known answer");
+            if(!mismatch.empty())
+                return mismatch;
+            stamps.push_back(known.stamp);
+        }
+
+        for(const auto& [stamp, expected] : knownFormats)
+        {
+            char formatted[formattedSize];
+            const std::string_view actual{ formatted, static_cast<std::size_t>(format(*parseDateAndTimeSpec(stamp), formatted) - formatted) };
+            if(actual != expected)
+                return "format(): " + quote(stamp) + " is written as " + quote(actual) + " instead of " + quote(expected);
+            stamps.push_back(stamp);
+        }
+
+        for(const auto& [stamp, year] : knownRfc5322Years)
+        {
+            const ParseResult result = Rfc5322Parser::parse(stamp);
+            if(!result || result.dateTime.year != year)
+                return "Rfc5322Parser: " + quote(stamp) + " isn't in " + std::to_string(year);
+            stamps.push_back(stamp);
+        }
+        return checkStamps(stamps.data(), stamps.size());
+    }
+
+    std::string checkInput(std::string_view input)
+    {
+        std::vector<std::string_view> stamps;
+        for(;;)
+        {
+            const std::size_t end = input.find('\n');
+            stamps.push_back(input.substr(0, end));
+            if(end == std::string_view::npos)
+                break;
+            input.remove_prefix(end + 1);
+        }
+        return checkStamps(stamps.data(), stamps.size());
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef RFC882DIFFERENTIAL_H
+#define RFC882DIFFERENTIAL_H
+
+/*
+Differential checks of the parser engines against the std::regex reference, parseDateAndTimeSpecRegex().
+They are shared by the fuzz target and the differential driver.
+
+For every stamp, each engine must make the same accept/reject decision as the reference, and for the
+stamps that parse, it must report the same time, the same dateTime and the same tokens (for the
+engines that report them). The engines are:
+
+    parse()                         parseDateAndTimeSpec()
+    parse<StrictWeekday>()          parseDateAndTimeSpec() on an arena (rfc882pmr.h)
+    parseCached(), twice            parseDateAndTimeSpecLazy()
+    parseConstexpr()                parseInline()
+    BasicParser<ReferenceDialect>   parseBatch(), over all the stamps at once
+    parseBatchParallel(), 3 threads StreamParser, fed in one chunk and in chunks of 1 to 16 bytes
+    SequentialParser, in order      ParsePipeline, fed in chunks of 1 to 16 bytes, in batches of 7
+    findAll(), on header lines
+
+prefilter() must pass every stamp that the reference accepts, and parse<StrictWeekday>() must accept
+exactly those whose day of week, if any, is the day of their date. parseImfFixdate() must accept exactly
+the IMF-fixdates among them, with the same results (but for the years 0000 - 0099), and parseHttpDate()
+as well, and also the RFC 850 and asctime() stamps, as the reference takes the same dates in its grammar.
+The other dialects of BasicParser must take the stamps of the reference as their settings say (the year
+digits, how the year is expanded and the day of week), and what else they accept must be what the
+reference takes in its grammar. The stamps that format() and formatAsParsed() (through toDateTime())
+write for each parsed one must parse back to the same time.
+
+The fixed-layout and calendar kernels that the CPU supports are also run directly, so that those the
+dispatch didn't pick are checked against the scalar ones.
+*/
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace rfc882::fuzz
+{
+    // Check every engine on count stamps. Returns a description of the first disagreement with the
+    // reference, or an empty string if every engine agrees.
+    std::string checkStamps(const std::string_view* stamps, std::size_t count);
+
+    // checkStamps() on input split at '\n', as StreamParser splits it.
+    std::string checkInput(std::string_view input);
+
+    // Check the reference and parse() against a table of stamps whose outcomes are known, such as the last
+    // day of February, and format() against the stamps it must write, then every engine against the
+    // reference on them.
+    std::string checkKnownAnswers();
+}
+
+#endif
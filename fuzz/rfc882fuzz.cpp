@@ -0,0 +1,75 @@
+/*
+libFuzzer target that checks every parser engine against the std::regex reference (see rfc882differential.h)
+and aborts on the first disagreement. The input is split into stamps at '\n'.
+
+    clang++ -g -O1 -std=c++17 -fsanitize=fuzzer,address,undefined fuzz/rfc882fuzz.cpp fuzz/rfc882differential.cpp rfc882*.cpp -o rfc882fuzz
+    ./rfc882fuzz -dict=fuzz/rfc882.dict fuzz/corpus
+
+It also builds with afl-clang-fast++ and -fsanitize=fuzzer for AFL++. Define RFC882_FUZZ_STANDALONE to
+build it with any compiler and without libFuzzer; it then checks the files given on the command line (or
+stdin if there are none), which is how AFL's own driver and crash reproducers run it:
+
+    g++ -O2 -std=c++17 -DRFC882_FUZZ_STANDALONE fuzz/rfc882fuzz.cpp fuzz/rfc882differential.cpp rfc882*.cpp -o rfc882fuzz
+    ./rfc882fuzz crash-0123abcd
+
+Years beyond 2262 and before 1678 don't fit in system_clock's nanoseconds. Every engine wraps the same
+way, so build without -fsanitize=signed-integer-overflow to fuzz with UBSan.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib> // for std::abort()
+#include <string>
+#include <string_view>
+
+#include "rfc882differential.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    const std::string mismatch = rfc882::fuzz::checkInput({ reinterpret_cast<const char*>(data), size });
+    if(!mismatch.empty())
+    {
+        std::fprintf(stderr, "%s\n", mismatch.c_str());
+        std::abort();
+    }
+    return 0;
+}
+
+#ifdef RFC882_FUZZ_STANDALONE
+
+#include <fstream>
+#include <iostream>
+#include <iterator> // for std::istreambuf_iterator
+
+namespace
+{
+    void run(std::istream& in)
+    {
+        const std::string input{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+        LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        run(std::cin);
+        return 0;
+    }
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::ifstream file{ argv[i], std::ios::binary };
+        if(!file)
+        {
+            std::fprintf(stderr, "rfc882fuzz: can't read %s\n", argv[i]);
+            return 1;
+        }
+        run(file);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,199 @@
+#include <cstring> // for std::memcpy()
+#include <utility> // for std::move()
+
+#include "rfc882cache.h"
+#include "rfc882inline.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        static_assert(stampCacheKeySize == 32, "Keys are loaded, compared and hashed as four 8-byte words");
+
+        // What a hit needs to rebuild the ParseResult of a stamp of at most stampCacheKeySize bytes:
+        // the offsets and lengths of the tokens fit in bytes, and the fields of the date in their ranges.
+        struct StampEntry
+        {
+            std::uint64_t key[4];           // The stamp, padded with zeros
+            std::int64_t ticks;             // time, in system_clock ticks
+            std::uint8_t tokens[16];        // Offset and length of each token
+            std::int16_t year;
+            std::int16_t timeZoneDifferential;
+            std::uint8_t day, month, hour, minute, second;
+            std::uint8_t length;            // Of the stamp; 0 means empty
+            bool valid;
+            ParseError error;
+            std::uint8_t errorOffset;
+        };
+
+        static_assert(sizeof(StampEntry) == 72, "StampEntry should stay small, so that the whole cache fits in L1");
+
+        struct Cache
+        {
+            StampEntry stamps[stampCacheEntries];
+            CacheStats stats;
+        };
+
+        // Constant-initialized, so that the thread_local needs no guard on every access
+        thread_local Cache cache{};
+
+        std::uint64_t loadWord(const char* bytes) noexcept
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        // The stamp, which must fit, as overlapping words loaded in place, from the front and from the back, which for a
+        // given size cover every byte. Copying it into a zero-padded block first would stall on store forwarding.
+        void loadKey(std::string_view stamp, std::uint64_t (&key)[4]) noexcept
+        {
+            const char* data = stamp.data();
+            const std::size_t size = stamp.size();
+            if(size >= 16)
+            {
+                key[0] = loadWord(data);
+                key[1] = loadWord(data + 8);
+                key[2] = loadWord(data + size - 16);
+                key[3] = loadWord(data + size - 8);
+                return;
+            }
+
+            key[0] = key[1] = key[2] = key[3] = 0;
+            if(size >= 8)
+            {
+                key[0] = loadWord(data);
+                key[1] = loadWord(data + size - 8);
+                return;
+            }
+            for(std::size_t i = 0; i < size; ++i)
+                key[0] |= std::uint64_t{ static_cast<unsigned char>(data[i]) } << (8 * i);
+        }
+
+        // The slot of a key: one multiply per word, independent of each other, and the slot from the top bits
+        // of their sum, which depend on every byte
+        std::size_t slot(const std::uint64_t (&key)[4]) noexcept
+        {
+            static_assert(stampCacheEntries == 256, "The slot is the top byte of the hash");
+            const std::uint64_t hash = key[0] * 0x9E3779B97F4A7C15ull + key[1] * 0xC2B2AE3D27D4EB4Full +
+                key[2] * 0x165667B19E3779F9ull + key[3] * 0xFF51AFD7ED558CCDull;
+            return static_cast<std::size_t>(hash >> 56);
+        }
+
+        bool keyEquals(const std::uint64_t (&x)[4], const std::uint64_t (&y)[4]) noexcept
+        {
+            return ((x[0] ^ y[0]) | (x[1] ^ y[1]) | (x[2] ^ y[2]) | (x[3] ^ y[3])) == 0;
+        }
+
+        void packTokens(const TokenSpan* spans, std::size_t count, std::uint8_t* packed) noexcept
+        {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                packed[2 * i] = static_cast<std::uint8_t>(spans[i].offset);
+                packed[2 * i + 1] = static_cast<std::uint8_t>(spans[i].length);
+            }
+        }
+
+        void unpackTokens(const std::uint8_t* packed, std::size_t count, TokenSpan* spans) noexcept
+        {
+            for(std::size_t i = 0; i < count; ++i)
+                spans[i] = { packed[2 * i], packed[2 * i + 1] };
+        }
+
+        // The tokens as an array, in the order in which they are declared
+        static_assert(sizeof(ParseResult::Tokens) == 8 * sizeof(TokenSpan), "Tokens should be 8 TokenSpans");
+
+        TokenSpan* spans(ParseResult::Tokens& tokens) noexcept
+        {
+            return &tokens.dayOfWeek;
+        }
+
+        const TokenSpan* spans(const ParseResult::Tokens& tokens) noexcept
+        {
+            return &tokens.dayOfWeek;
+        }
+
+        void store(StampEntry& entry, const std::uint64_t (&key)[4], std::size_t length, const ParseResult& result) noexcept
+        {
+            std::memcpy(entry.key, key, sizeof(key));
+            entry.ticks = result.time.time_since_epoch().count();
+            packTokens(spans(result.tokens), 8, entry.tokens);
+            entry.year = static_cast<std::int16_t>(result.dateTime.year);
+            entry.timeZoneDifferential = static_cast<std::int16_t>(result.dateTime.timeZoneDifferential.count());
+            entry.day = static_cast<std::uint8_t>(result.dateTime.day);
+            entry.month = static_cast<std::uint8_t>(result.dateTime.month);
+            entry.hour = static_cast<std::uint8_t>(result.dateTime.hour);
+            entry.minute = static_cast<std::uint8_t>(result.dateTime.minute);
+            entry.second = static_cast<std::uint8_t>(result.dateTime.second);
+            entry.length = static_cast<std::uint8_t>(length);
+            entry.valid = result.valid;
+            entry.error = result.error;
+            entry.errorOffset = static_cast<std::uint8_t>(result.errorOffset);
+        }
+
+        ParseResult load(const StampEntry& entry) noexcept
+        {
+            ParseResult result;
+            result.time = std::chrono::system_clock::time_point{ std::chrono::system_clock::duration{ entry.ticks } };
+            unpackTokens(entry.tokens, 8, spans(result.tokens));
+            result.dateTime.day = entry.day;
+            result.dateTime.month = entry.month;
+            result.dateTime.year = entry.year;
+            result.dateTime.hour = entry.hour;
+            result.dateTime.minute = entry.minute;
+            result.dateTime.second = entry.second;
+            result.dateTime.timeZoneDifferential = std::chrono::minutes{ entry.timeZoneDifferential };
+            result.valid = entry.valid;
+            result.error = entry.error;
+            result.errorOffset = entry.errorOffset;
+            return result;
+        }
+
+        // Rejections are cached too, since garbage repeats as much as valid stamps do.
+        // The only return, so that the result is built in place instead of copied out of a partly written block.
+        ParseResult parseAndStore(std::string_view stamp, StampEntry& entry, const std::uint64_t (&key)[4]) noexcept
+        {
+            bool fixedLayout = false;
+            ParseResult result = detail::parseStamp<LenientWeekday>(stamp, fixedLayout);
+            store(entry, key, stamp.size(), result);
+            return result;
+        }
+    }
+
+    ParseResult parseCached(std::string_view stamp) noexcept
+    {
+        if(stamp.empty() || stamp.size() > stampCacheKeySize)
+            return parseInline(stamp);
+
+        Cache& local = cache;
+        std::uint64_t key[4];
+        loadKey(stamp, key);
+        StampEntry& entry = local.stamps[slot(key)];
+        if(entry.length == stamp.size() && keyEquals(entry.key, key))
+        {
+            ++local.stats.stampHits;
+            return load(entry);
+        }
+        ++local.stats.stampMisses;
+        return parseAndStore(stamp, entry, key);
+    }
+
+    std::optional<RFC882DateTime> parseDateAndTimeSpecCached(std::string stamp)
+    {
+        const ParseResult result = parseCached(stamp);
+        return toDateTime(std::move(stamp), result);
+    }
+
+    CacheStats cacheStats() noexcept
+    {
+        return cache.stats;
+    }
+
+    void resetCache() noexcept
+    {
+        Cache& local = cache;
+        for(auto& entry : local.stamps)
+            entry.length = 0;
+        local.stats = CacheStats{};
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef RFC882CACHE_H
+#define RFC882CACHE_H
+
+/*
+Optional memoizing layer in front of parse() for inputs that repeat, such as feed items that are polled repeatedly.
+
+Each thread has its own cache, so there are no locks. It is a direct-mapped cache of whole stamps (up to
+stampCacheKeySize characters each), bounded at 18 KB per thread so that it stays in L1. A hit rebuilds the
+stored result without scanning anything; a miss runs parse() and stores the compact result in its slot.
+
+A hit takes about half the time of parse() and a miss somewhat more than parse(), so the cache only pays off
+when about half of the stamps or more repeat one of the last few hundred (see README.md).
+
+The results are always the same as parse().
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    constexpr std::size_t stampCacheEntries = 256;
+    constexpr std::size_t stampCacheKeySize = 32;
+
+    // Counters for the calling thread's cache. Stamps that are empty or too long to be cached are not counted.
+    struct CacheStats
+    {
+        std::uint64_t stampHits = 0;
+        std::uint64_t stampMisses = 0;
+    };
+
+    // Same as parse(), through the calling thread's cache.
+    ParseResult parseCached(std::string_view stamp) noexcept;
+
+    // Same as parseDateAndTimeSpec(), through the calling thread's cache.
+    std::optional<RFC882DateTime> parseDateAndTimeSpecCached(std::string stamp);
+
+    CacheStats cacheStats() noexcept;
+
+    // Drop every cached entry of the calling thread and reset its counters.
+    void resetCache() noexcept;
+}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef RFC882CALENDAR_H
+#define RFC882CALENDAR_H
+
+/*
+Civil (proleptic Gregorian) calendar conversions and date validation shared by the parsers and the formatter.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    // Algorithm: http://howardhinnant.github.io/date_algorithms.html
+    // This is a public domain function.
+    // So let's not reinvent the wheel. Howard Hinnant designed std::chrono...
+    // =====================================================================================
+    // Returns number of days since civil 1970-01-01.  Negative values indicate
+    //    days prior to 1970-01-01.
+    // Preconditions:  y-m-d represents a date in the civil (Gregorian) calendar
+    //                 m is in [1, 12]
+    //                 d is in [1, last_day_of_month(y, m)]
+    //                 y is "approximately" in
+    //                   [numeric_limits<Int>::min()/366, numeric_limits<Int>::max()/366]
+    //                 Exact range of validity is:
+    //                 [civil_from_days(numeric_limits<Int>::min()),
+    //                  civil_from_days(numeric_limits<Int>::max()-719468)]
+    template <class Int>
+    constexpr Int days_from_civil(Int y, unsigned m, unsigned d) noexcept
+    {
+        static_assert(std::numeric_limits<unsigned>::digits >= 18,
+            "This algorithm has not been ported to a 16 bit unsigned integer");
+        static_assert(std::numeric_limits<Int>::digits >= 20,
+            "This algorithm has not been ported to a 16 bit signed integer");
+        y -= m <= 2;
+        const Int era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);          // [0, 399]
+        const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;// [0, 365]
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;         // [0, 146096]
+        return era * 146097 + static_cast<Int>(doe) - 719468;
+    }
+
+    template <class Int>
+    struct civil_date
+    {
+        Int y;
+        unsigned m;
+        unsigned d;
+    };
+
+    // Returns year/month/day triple in civil calendar
+    // Preconditions:  z is number of days since 1970-01-01 and is in the range:
+    //                   [numeric_limits<Int>::min(), numeric_limits<Int>::max()-719468].
+    template <class Int>
+    constexpr civil_date<Int> civil_from_days(Int z) noexcept
+    {
+        static_assert(std::numeric_limits<unsigned>::digits >= 18,
+            "This algorithm has not been ported to a 16 bit unsigned integer");
+        static_assert(std::numeric_limits<Int>::digits >= 20,
+            "This algorithm has not been ported to a 16 bit signed integer");
+        z += 719468;
+        const Int era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);          // [0, 146096]
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+        const Int y = static_cast<Int>(yoe) + era * 400;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);         // [0, 365]
+        const unsigned mp = (5 * doy + 2) / 153;                              // [0, 11]
+        const unsigned d = doy - (153 * mp + 2) / 5 + 1;                      // [1, 31]
+        const unsigned m = mp < 10 ? mp + 3 : mp - 9;                         // [1, 12]
+        return { y + (m <= 2), m, d };
+    }
+
+    // Returns day of week in civil calendar [0, 6] -> [Sun, Sat]
+    // Preconditions:  z is number of days since 1970-01-01 and is in the range:
+    //                   [numeric_limits<Int>::min(), numeric_limits<Int>::max()-4].
+    template <class Int>
+    constexpr unsigned weekday_from_days(Int z) noexcept
+    {
+        return static_cast<unsigned>(z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6);
+    }
+
+    namespace detail
+    {
+        // The number of days in each month of a common year, by month [1 - 12]. Invalid months have 0 days.
+        inline constexpr std::array<std::uint8_t, 13> daysInMonthTable{ 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+        // daysInMonthTable packed into an integer, as 2 bits per month (the days after the 28th, at bit 2 * month),
+        // so the vector kernels can look it up with a shift. The invalid months must be masked out by the caller.
+        constexpr std::uint32_t packDaysInMonth() noexcept
+        {
+            std::uint32_t packed = 0;
+            for(unsigned month = 1; month < daysInMonthTable.size(); ++month)
+                packed |= static_cast<std::uint32_t>(daysInMonthTable[month] - 28) << (2 * month);
+            return packed;
+        }
+
+        inline constexpr std::uint32_t packedDaysInMonth = packDaysInMonth();
+
+        // The index of month in daysInMonthTable: month if it is valid, 0 otherwise.
+        constexpr unsigned monthIndex(int month) noexcept
+        {
+            const unsigned index = static_cast<unsigned>(month);
+            return index - 1 < 12 ? index : 0;
+        }
+    }
+
+    // A year is a leap year if it is divisible by 4 and either not divisible by 100, or divisible by 400.
+    // For a multiple of 4, divisible by 100 is the same as divisible by 25, and divisible by 400 as divisible by 16.
+    constexpr bool isLeapYear(int year) noexcept
+    {
+        return ((year & 3) == 0) & ((year % 25 != 0) | ((year & 15) == 0));
+    }
+
+    // The number of days in month [1 - 12] of year, or 0 if month is out of range.
+    constexpr int daysInMonth(int year, int month) noexcept
+    {
+        const unsigned index = detail::monthIndex(month);
+        return detail::daysInMonthTable[index] + ((index == 2) & isLeapYear(year));
+    }
+
+    [[nodiscard]] constexpr bool isValidDate(const RFC882DateTime::DateTime& date) noexcept
+    {
+        // day - 1 wraps around for days below 1
+        return static_cast<unsigned>(date.day) - 1 < static_cast<unsigned>(daysInMonth(date.year, date.month));
+    }
+
+    [[nodiscard]] constexpr bool isValidTime(const RFC882DateTime::DateTime& date) noexcept
+    {
+        return
+            (static_cast<unsigned>(date.hour) < 24) &
+            (static_cast<unsigned>(date.minute) < 60) &
+            (static_cast<unsigned>(date.second) < 60);
+    }
+
+    namespace detail
+    {
+        // Check date with isValidDate() and isValidTime(), and compute its day number as days_from_civil() does,
+        // in one branchless pass that shares the month lookup. daysFromEpoch is unspecified if date isn't valid.
+        constexpr bool validateDays(const RFC882DateTime::DateTime& date, std::int64_t& daysFromEpoch) noexcept
+        {
+            const unsigned month = monthIndex(date.month);
+            const unsigned days = daysInMonthTable[month] + ((month == 2) & isLeapYear(date.year));
+            const bool valid = (static_cast<unsigned>(date.day) - 1 < days) & isValidTime(date);
+
+            // days_from_civil(), with March as the first month of the year
+            const std::int64_t year = static_cast<std::int64_t>(date.year) - (month <= 2);
+            const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+            const unsigned yoe = static_cast<unsigned>(year - era * 400);                       // [0, 399]
+            const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + static_cast<unsigned>(date.day) - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            daysFromEpoch = era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+            return valid;
+        }
+    }
+
+    namespace detail
+    {
+        // Check the fields of a scanned stamp with isValidDate() and isValidTime(). If they are out of
+        // bounds, record an outOfRange error at the first bad field and return false.
+        constexpr bool checkBounds(ParseResult& result) noexcept
+        {
+            const RFC882DateTime::DateTime& date = result.dateTime;
+            const TokenSpan* bad = nullptr;
+            if(!isValidDate(date))
+                bad = &result.tokens.day;
+            else if(date.hour < 0 || date.hour > 23)
+                bad = &result.tokens.hour;
+            else if(date.minute < 0 || date.minute > 59)
+                bad = &result.tokens.minute;
+            else if(!isValidTime(date))
+                bad = &result.tokens.second;
+            else
+                return true;
+
+            result.error = ParseError::outOfRange;
+            result.errorOffset = bad->offset;
+            return false;
+        }
+
+        // checkBounds() that also computes the day number of the date with validateDays().
+        // daysFromEpoch is unspecified if the fields are out of bounds.
+        constexpr bool checkBounds(ParseResult& result, std::int64_t& daysFromEpoch) noexcept
+        {
+            return validateDays(result.dateTime, daysFromEpoch) || checkBounds(result);
+        }
+    }
+
+    namespace detail
+    {
+        // Check that the day of week of a scanned stamp (0 is Sunday, negative if the stamp has none) is the
+        // day implied by the date, whose day number from days_from_civil() is daysFromEpoch. If it isn't,
+        // record a weekdayMismatch error at the day of week and return false.
+        constexpr bool checkWeekday(ParseResult& result, int weekday, std::int64_t daysFromEpoch) noexcept
+        {
+            if(weekday < 0 || weekday == static_cast<int>(weekday_from_days(daysFromEpoch)))
+                return true;
+
+            result.error = ParseError::weekdayMismatch;
+            result.errorOffset = result.tokens.dayOfWeek.offset;
+            return false;
+        }
+    }
+
+    // The UTC time point for date, given its day number from days_from_civil().
+    // This is split out so callers that already have the day number (or have cached it) can skip the calendar math.
+    constexpr std::chrono::system_clock::time_point generateUTCTime(const RFC882DateTime::DateTime& date, std::int64_t daysFromEpoch) noexcept
+    {
+        const std::int64_t localizedTime = (((
+            (24 * daysFromEpoch + date.hour) * 60) // convert days/hour to minutes
+            + date.minute) * 60) // convert minutes to seconds
+            + date.second; // add remaining seconds
+
+        // Then convert that to a std::chrono time_point and then convert to UTC
+        return std::chrono::system_clock::time_point{ std::chrono::seconds{ localizedTime } } - date.timeZoneDifferential;
+    }
+
+    constexpr std::chrono::system_clock::time_point generateUTCTime(const RFC882DateTime::DateTime& date) noexcept
+    {
+        // In C++17, there's no good built-in way to handle calendars (coming in C++20).
+        // Instead, count the days and seconds from the Unix epoch ourselves, which is also what std::time_t does.
+
+        // Get number of days from Unix epoch: January 1, 1970
+        return generateUTCTime(date, days_from_civil<std::int64_t>(date.year, date.month, date.day));
+    }
+}
+
+#endif
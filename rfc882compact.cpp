@@ -0,0 +1,62 @@
+#include <cstring> // for std::memcpy()
+#include <utility> // for std::move()
+
+#include "rfc882compact.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        // Where the fields are in the output of format(): "Ddd, DD Mon YYYY HH:MM:SS +HHMM"
+        constexpr std::size_t canonicalDay = 5;
+        constexpr std::size_t canonicalYear = 12;
+        constexpr std::size_t canonicalTime = 17;
+        constexpr std::size_t canonicalZone = 26;
+
+        char* copy(char* out, const char* from, std::size_t size) noexcept
+        {
+            std::memcpy(out, from, size);
+            return out + size;
+        }
+    }
+
+    char* formatAsParsed(const CompactDateTime& date, char* out) noexcept
+    {
+        // Format the canonical stamp, and keep the parts of it that the original had
+        char canonical[formattedSize];
+        format(date, canonical);
+
+        if(date.has(CompactDateTime::hadWeekday))
+            out = copy(out, canonical, canonicalDay);
+
+        // A 1-digit day is below 10, so its canonical form has a leading 0
+        const std::size_t dayDigits = date.has(CompactDateTime::oneDigitDay) ? 1 : 2;
+        out = copy(out, canonical + canonicalDay + 2 - dayDigits, dayDigits + 5); // "D Mon "
+
+        // 2-digit years are 2000 - 2099
+        const std::size_t yearDigits = date.has(CompactDateTime::twoDigitYear) ? 2 : 4;
+        out = copy(out, canonical + canonicalYear + 4 - yearDigits, yearDigits + 1);
+
+        out = copy(out, canonical + canonicalTime, date.has(CompactDateTime::hadSeconds) ? 8 : 5);
+        *out++ = ' ';
+
+        if(date.zone == 0 || date.zone > compactZoneNames.size())
+            return copy(out, canonical + canonicalZone, 5);
+        const std::string_view name = compactZoneNames[date.zone - 1];
+        return copy(out, name.data(), name.size());
+    }
+
+    std::string formatAsParsed(const CompactDateTime& date)
+    {
+        char buffer[formattedSize];
+        const char* end = formatAsParsed(date, buffer);
+        return { buffer, static_cast<std::size_t>(end - buffer) };
+    }
+
+    std::optional<RFC882DateTime> toDateTime(const CompactDateTime& date)
+    {
+        std::string stamp = formatAsParsed(date);
+        const ParseResult result = parse(stamp);
+        return toDateTime(std::move(stamp), result);
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef RFC882COMPACT_H
+#define RFC882COMPACT_H
+
+/*
+CompactDateTime is a 16-byte summary of a parsed stamp, for holding many of them (an RFC882DateTime
+is 328 bytes with libstdc++, a ParseResult 112). It keeps the UTC time, the time zone differential and
+the shape of the stamp: whether it had a day of week and seconds, the widths of the day and year, and
+the zone name if it was one of the RFC882 zones.
+
+    const rfc882::CompactDateTime date = rfc882::compact(stamp, rfc882::parse(stamp));
+
+The canonical stamp is written by format(), and formatAsParsed() writes the stamp in its original
+shape (with single spaces), which parses back to a CompactDateTime at the same time. The round trip
+isn't the identity, because only the shape is kept and not the text:
+
+  - The day of week is written as the day of the date, which parse() doesn't check against the
+    original one.
+  - The year is written with as many digits as the original (2 or 4), but a 2-digit year is only
+    right for 2000 - 2099, which is what the parser makes of it.
+  - Zones that aren't RFC882 zones, such as those of ExtendedParser, are kept as their differential,
+    and differentials beyond +/-99:59 (such as "+9999") are clamped to it, as format() does.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "rfc882datetime.h"
+#include "rfc882format.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    struct CompactDateTime
+    {
+        enum Flags : std::uint8_t
+        {
+            hadWeekday = 1,
+            hadSeconds = 2,
+            twoDigitYear = 4,
+            oneDigitDay = 8
+        };
+
+        std::int64_t seconds = 0;                       // UTC seconds since 1970-01-01
+        std::int16_t timeZoneDifferential = 0;          // In minutes
+        std::uint8_t flags = 0;                         // Flags of the stamp's shape
+        std::uint8_t zone = 0;                          // 0 for a numeric differential, otherwise 1 + the index of the name in compactZoneNames
+
+        constexpr bool has(Flags flag) const noexcept { return (flags & flag) != 0; }
+
+        constexpr std::chrono::system_clock::time_point time() const noexcept
+        {
+            return std::chrono::system_clock::time_point{ std::chrono::seconds{ seconds } };
+        }
+
+        constexpr std::chrono::minutes differential() const noexcept { return std::chrono::minutes{ timeZoneDifferential }; }
+    };
+
+    static_assert(sizeof(CompactDateTime) == 16, "CompactDateTime should stay 16 bytes");
+
+    // The zone names that CompactDateTime::zone refers to. The order is part of the representation.
+    inline constexpr std::array<std::string_view, 15> compactZoneNames{
+        "UT", "GMT", "EST", "EDT", "CST", "CDT", "MST", "MDT", "PST", "PDT", "Z", "A", "M", "N", "Y" };
+
+    namespace detail
+    {
+        inline constexpr auto compactZoneTable = makeNameTable<std::uint8_t>({
+            { "UT", 1 }, { "GMT", 2 }, { "EST", 3 }, { "EDT", 4 }, { "CST", 5 }, { "CDT", 6 }, { "MST", 7 }, { "MDT", 8 },
+            { "PST", 9 }, { "PDT", 10 }, { "Z", 11 }, { "A", 12 }, { "M", 13 }, { "N", 14 }, { "Y", 15 } });
+
+        constexpr CompactDateTime compact(std::int64_t seconds, std::chrono::minutes differential, bool weekday, bool secondsToken,
+            std::size_t dayLength, std::size_t yearLength, std::string_view zone) noexcept
+        {
+            CompactDateTime date;
+            date.seconds = seconds;
+            date.timeZoneDifferential = static_cast<std::int16_t>(differential.count());
+            date.flags = static_cast<std::uint8_t>((weekday ? CompactDateTime::hadWeekday : 0) |
+                (secondsToken ? CompactDateTime::hadSeconds : 0) |
+                (yearLength == 2 ? CompactDateTime::twoDigitYear : 0) |
+                (dayLength == 1 ? CompactDateTime::oneDigitDay : 0));
+            date.zone = compactZoneTable.find(zone).value_or(0);
+            return date;
+        }
+    }
+
+    // Summarize a parsed stamp. result must come from parsing stamp and be valid.
+    constexpr CompactDateTime compact(std::string_view stamp, const ParseResult& result) noexcept
+    {
+        return detail::compact(std::chrono::duration_cast<std::chrono::seconds>(result.time.time_since_epoch()).count(),
+            result.dateTime.timeZoneDifferential, result.tokens.dayOfWeek.length != 0, result.tokens.second.length != 0,
+            result.tokens.day.length, result.tokens.year.length, token(stamp, result.tokens.timeZone));
+    }
+
+    inline CompactDateTime compact(const RFC882DateTime& date) noexcept
+    {
+        return detail::compact(std::chrono::duration_cast<std::chrono::seconds>(date.time.time_since_epoch()).count(),
+            date.dateTime.timeZoneDifferential, !date.tokens.dayOfWeek.empty(), !date.tokens.second.empty(),
+            date.tokens.day.size(), date.tokens.year.size(), date.tokens.timeZone);
+    }
+
+    // Write the canonical stamp for date; see rfc882format.h.
+    inline char* format(const CompactDateTime& date, char* out) noexcept
+    {
+        return format(date.time(), date.differential(), out);
+    }
+
+    // Write the stamp in the shape it was parsed from, with single spaces, into out, which must have room
+    // for formattedSize characters. Returns a pointer past the last character written.
+    // Has the preconditions of format(), and date.time() must be representable as a system_clock::time_point
+    // (years 1678 - 2262 with 64-bit nanosecond clocks).
+    char* formatAsParsed(const CompactDateTime& date, char* out) noexcept;
+
+    // Convenience overload that allocates.
+    std::string formatAsParsed(const CompactDateTime& date);
+
+    // The RFC882DateTime of the stamp written by formatAsParsed(), or std::nullopt if it doesn't parse back,
+    // which only happens when date breaks the preconditions of formatAsParsed().
+    std::optional<RFC882DateTime> toDateTime(const CompactDateTime& date);
+
+    // Comparison operators, by time as for RFC882DateTime.
+    constexpr bool operator<(const CompactDateTime& x, const CompactDateTime& y) noexcept
+    {
+        return x.seconds < y.seconds;
+    }
+
+    constexpr bool operator<=(const CompactDateTime& x, const CompactDateTime& y) noexcept
+    {
+        return x.seconds <= y.seconds;
+    }
+
+    constexpr bool operator>(const CompactDateTime& x, const CompactDateTime& y) noexcept
+    {
+        return x.seconds > y.seconds;
+    }
+
+    constexpr bool operator>=(const CompactDateTime& x, const CompactDateTime& y) noexcept
+    {
+        return x.seconds >= y.seconds;
+    }
+
+    constexpr bool operator==(const CompactDateTime& x, const CompactDateTime& y) noexcept
+    {
+        return x.seconds == y.seconds;
+    }
+}
+
+#endif
@@ -1,134 +1,316 @@
-#ifndef RFC882DATETIME_H
-#define RFC882DATETIME_H
-
-/* 
-Parse RFC882 Date and Time Specification
-https://tools.ietf.org/html/rfc822#section-5.1
-There is one exception: Whereas the spec calls for a two-digit year, 
-this library will accept years with four digits, as preferred by RSS feeds.
-See https://validator.w3.org/feed/docs/rss2.html
-*/
-
-/*
- 5.  DATE AND TIME SPECIFICATION
-
-     5.1.  SYNTAX
-
-     date-time   =  [ day "," ] date time        ; dd mm yy
-                                                 ;  hh:mm:ss zzz
-
-     day         =  "Mon"  / "Tue" /  "Wed"  / "Thu"
-                 /  "Fri"  / "Sat" /  "Sun"
-
-     date        =  1*2DIGIT month 2DIGIT        ; day month year
-                                                 ;  e.g. 20 Jun 82
-
-     month       =  "Jan"  /  "Feb" /  "Mar"  /  "Apr"
-                 /  "May"  /  "Jun" /  "Jul"  /  "Aug"
-                 /  "Sep"  /  "Oct" /  "Nov"  /  "Dec"
-
-     time        =  hour zone                    ; ANSI and Military
-
-     hour        =  2DIGIT ":" 2DIGIT [":" 2DIGIT]
-                                                 ; 00:00:00 - 23:59:59
-
-     zone        =  "UT"  / "GMT"                ; Universal Time
-                                                 ; North American : UT
-                 /  "EST" / "EDT"                ;  Eastern:  - 5/ - 4
-                 /  "CST" / "CDT"                ;  Central:  - 6/ - 5
-                 /  "MST" / "MDT"                ;  Mountain: - 7/ - 6
-                 /  "PST" / "PDT"                ;  Pacific:  - 8/ - 7
-                 /  1ALPHA                       ; Military: Z = UT;
-                                                 ;  A:-1; (J not used)
-                                                 ;  M:-12; N:+1; Y:+12
-                 / ( ("+" / "-") 4DIGIT )        ; Local differential
-                                                 ;  hours+min. (HHMM)
-
-     5.2.  SEMANTICS
-
-          If included, day-of-week must be the day implied by the date
-     specification.
-
-          Time zone may be indicated in several ways.  "UT" is Univer-
-     sal  Time  (formerly called "Greenwich Mean Time"); "GMT" is per-
-     mitted as a reference to Universal Time.  The  military  standard
-     uses  a  single  character for each zone.  "Z" is Universal Time.
-     "A" indicates one hour earlier, and "M" indicates 12  hours  ear-
-     lier;  "N"  is  one  hour  later, and "Y" is 12 hours later.  The
-     letter "J" is not used.  The other remaining two forms are  taken
-     from ANSI standard X3.51-1975.  One allows explicit indication of
-     the amount of offset from UT; the other uses  common  3-character
-     strings for indicating time zones in North America.
- */
-
-#include <chrono>
-#include <optional>
-#include <string>
-
-namespace rfc882
-{
-    struct RFC882DateTime
-    {
-        std::string stamp;                              // The RFC882 formatted time stamp, unaltered.
-        std::chrono::system_clock::time_point time{};   // The point in time that this time stamp represents, in UTC.
-        
-        struct Tokens
-        {
-            std::string dayOfWeek;                      // optional: Mon, Tue, Wed, Thu, Fri, Sat, Sun
-            std::string day;                            // 2 digits
-            std::string month;                          // Jan, Feb, Mar, etc...
-            std::string year;                           // 2 or 4 digits
-
-            std::string hour;                           // 2 digits
-            std::string minute;                         // 2 digits
-            std::string second;                         // optional: 2 digits
-
-            std::string timeZone;                       // Limited time zones like EST, EDT, etc. or differential such as -0500.
-        } tokens;
-
-        // Note: these values are not adjusted by the time zone differential
-        struct DateTime
-        {
-            int day    = 1;        // day of month [1 - 31] (depending on the month)
-            int month  = 1;        // month of year [1 - 12]
-            int year   = 1970;     // year (2 digit years are added to 2000)
-
-            int hour   = 0;        // hour [0 - 23]
-            int minute = 0;        // minute [0 - 59]
-            int second = 0;        // second [0 - 59]
-
-            std::chrono::minutes timeZoneDifferential{};  // Examples: EST = -5 * 60, +1230 = 12 * 60 + 30
-        } dateTime;
-    };
-
-    // Take an RFC882 Date and Time and try to parse it into an RFC882DateTime structure.
-    std::optional<RFC882DateTime> parseDateAndTimeSpec(std::string stamp);
-
-    // Comparison operators. In C++20, these can be replaced by overloading <=>.
-    inline bool operator<(const RFC882DateTime& x, const RFC882DateTime& y)
-    {
-        return x.time < y.time;
-    }
-
-    inline bool operator<=(const RFC882DateTime& x, const RFC882DateTime& y)
-    {
-        return x.time <= y.time;
-    }
-
-    inline bool operator>(const RFC882DateTime& x, const RFC882DateTime& y)
-    {
-        return x.time > y.time;
-    }
-
-    inline bool operator>=(const RFC882DateTime& x, const RFC882DateTime& y)
-    {
-        return x.time >= y.time;
-    }
-
-    inline bool operator==(const RFC882DateTime& x, const RFC882DateTime& y)
-    {
-        return x.time == y.time;
-    }
-}
-
-#endif
+#ifndef RFC882DATETIME_H
+#define RFC882DATETIME_H
+
+/* 
+Parse RFC882 Date and Time Specification
+https://tools.ietf.org/html/rfc822#section-5.1
+There is one exception: Whereas the spec calls for a two-digit year, 
+this library will accept years with four digits, as preferred by RSS feeds.
+See https://validator.w3.org/feed/docs/rss2.html
+*/
+
+/*
+ 5.  DATE AND TIME SPECIFICATION
+
+     5.1.  SYNTAX
+
+     date-time   =  [ day "," ] date time        ; dd mm yy
+                                                 ;  hh:mm:ss zzz
+
+     day         =  "Mon"  / "Tue" /  "Wed"  / "Thu"
+                 /  "Fri"  / "Sat" /  "Sun"
+
+     date        =  1*2DIGIT month 2DIGIT        ; day month year
+                                                 ;  e.g. 20 Jun 82
+
+     month       =  "Jan"  /  "Feb" /  "Mar"  /  "Apr"
+                 /  "May"  /  "Jun" /  "Jul"  /  "Aug"
+                 /  "Sep"  /  "Oct" /  "Nov"  /  "Dec"
+
+     time        =  hour zone                    ; ANSI and Military
+
+     hour        =  2DIGIT ":" 2DIGIT [":" 2DIGIT]
+                                                 ; 00:00:00 - 23:59:59
+
+     zone        =  "UT"  / "GMT"                ; Universal Time
+                                                 ; North American : UT
+                 /  "EST" / "EDT"                ;  Eastern:  - 5/ - 4
+                 /  "CST" / "CDT"                ;  Central:  - 6/ - 5
+                 /  "MST" / "MDT"                ;  Mountain: - 7/ - 6
+                 /  "PST" / "PDT"                ;  Pacific:  - 8/ - 7
+                 /  1ALPHA                       ; Military: Z = UT;
+                                                 ;  A:-1; (J not used)
+                                                 ;  M:-12; N:+1; Y:+12
+                 / ( ("+" / "-") 4DIGIT )        ; Local differential
+                                                 ;  hours+min. (HHMM)
+
+     5.2.  SEMANTICS
+
+          If included, day-of-week must be the day implied by the date
+     specification.
+
+          Time zone may be indicated in several ways.  "UT" is Univer-
+     sal  Time  (formerly called "Greenwich Mean Time"); "GMT" is per-
+     mitted as a reference to Universal Time.  The  military  standard
+     uses  a  single  character for each zone.  "Z" is Universal Time.
+     "A" indicates one hour earlier, and "M" indicates 12  hours  ear-
+     lier;  "N"  is  one  hour  later, and "Y" is 12 hours later.  The
+     letter "J" is not used.  The other remaining two forms are  taken
+     from ANSI standard X3.51-1975.  One allows explicit indication of
+     the amount of offset from UT; the other uses  common  3-character
+     strings for indicating time zones in North America.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility> // for std::move()
+
+#include "rfc882tables.h"
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#define RFC882_HAS_SPAN 1
+#endif
+
+namespace rfc882
+{
+    struct RFC882DateTime
+    {
+        std::string stamp;                              // The RFC882 formatted time stamp, unaltered.
+        std::chrono::system_clock::time_point time{};   // The point in time that this time stamp represents, in UTC.
+        
+        struct Tokens
+        {
+            std::string dayOfWeek;                      // optional: Mon, Tue, Wed, Thu, Fri, Sat, Sun
+            std::string day;                            // 2 digits
+            std::string month;                          // Jan, Feb, Mar, etc...
+            std::string year;                           // 2 or 4 digits
+
+            std::string hour;                           // 2 digits
+            std::string minute;                         // 2 digits
+            std::string second;                         // optional: 2 digits
+
+            std::string timeZone;                       // Limited time zones like EST, EDT, etc. or differential such as -0500.
+        } tokens;
+
+        // Note: these values are not adjusted by the time zone differential
+        struct DateTime
+        {
+            int day    = 1;        // day of month [1 - 31] (depending on the month)
+            int month  = 1;        // month of year [1 - 12]
+            int year   = 1970;     // year (2 digit years are added to 2000)
+
+            int hour   = 0;        // hour [0 - 23]
+            int minute = 0;        // minute [0 - 59]
+            int second = 0;        // second [0 - 59]
+
+            std::chrono::minutes timeZoneDifferential{};  // Examples: EST = -5 * 60, +1230 = 12 * 60 + 30
+        } dateTime;
+    };
+
+    // Location of a token within a parsed stamp. Absent optional tokens have a length of 0.
+    struct TokenSpan
+    {
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    // Why a stamp was rejected by parse(). Each error is reported at the byte where scanning stopped,
+    // and whitespace that must follow a token belongs to that token: "07Oct" is a badDay at offset 2.
+    enum class ParseError : std::uint8_t
+    {
+        none,
+        badWeekday,         // Letters where the date starts, that aren't a day of week followed by ","
+        badDay,
+        badMonth,
+        badYear,
+        badTime,            // The hour, minute or second
+        badZone,            // Reported at the start of the zone, which must run to the end of the stamp
+        outOfRange,         // The date or time isn't in normal bounds (31 Apr, 24:00), reported at its first bad field
+        weekdayMismatch     // The day of week isn't the one implied by the date. Only checked by parse<StrictWeekday>().
+    };
+
+    constexpr std::size_t parseErrorCount = static_cast<std::size_t>(ParseError::weekdayMismatch) + 1;
+
+    constexpr std::string_view parseErrorName(ParseError error) noexcept
+    {
+        switch(error)
+        {
+        case ParseError::none: return "none";
+        case ParseError::badWeekday: return "badWeekday";
+        case ParseError::badDay: return "badDay";
+        case ParseError::badMonth: return "badMonth";
+        case ParseError::badYear: return "badYear";
+        case ParseError::badTime: return "badTime";
+        case ParseError::badZone: return "badZone";
+        case ParseError::outOfRange: return "outOfRange";
+        case ParseError::weekdayMismatch: return "weekdayMismatch";
+        }
+        return "unknown";
+    }
+
+    // Allocation-free, trivially copyable counterpart of RFC882DateTime returned by parse().
+    // The tokens refer back into the parsed stamp instead of copying it; see token().
+    struct ParseResult
+    {
+        std::chrono::system_clock::time_point time{};   // The point in time that this time stamp represents, in UTC.
+
+        struct Tokens
+        {
+            TokenSpan dayOfWeek;
+            TokenSpan day;
+            TokenSpan month;
+            TokenSpan year;
+
+            TokenSpan hour;
+            TokenSpan minute;
+            TokenSpan second;
+
+            TokenSpan timeZone;
+        } tokens;
+
+        RFC882DateTime::DateTime dateTime;
+
+        bool valid = false;                             // false if the stamp could not be parsed; only the error is meaningful then.
+        ParseError error = ParseError::none;            // Why the stamp could not be parsed
+        std::uint32_t errorOffset = 0;                  // Where in the stamp, in bytes
+
+        constexpr explicit operator bool() const noexcept { return valid; }
+    };
+
+    // Get the text of a token. stamp must be the same stamp that was passed to parse().
+    constexpr std::string_view token(std::string_view stamp, TokenSpan span) noexcept
+    {
+        return stamp.substr(span.offset, span.length);
+    }
+
+    // Take an RFC882 Date and Time and try to parse it without allocating or copying.
+    // Accepts exactly the same stamps as parseDateAndTimeSpec(). Rejected stamps are zero-initialized
+    // apart from the error and its offset.
+    ParseResult parse(std::string_view stamp) noexcept;
+
+    // Weekday policies for parse<WeekdayPolicy>(), which say whether the day of week, if present, must be
+    // the day implied by the date (RFC 822 section 5.2). Like the reference implementation, plain parse()
+    // is lenient. The check reuses the day number computed for the time, and costs nothing when lenient.
+    struct LenientWeekday
+    {
+        static constexpr bool checkWeekday = false;
+    };
+
+    struct StrictWeekday
+    {
+        static constexpr bool checkWeekday = true;
+    };
+
+    // parse() with the given weekday policy. Strict parsing rejects "Mon, 7 Oct 2014 ..." as a weekdayMismatch.
+    template <class WeekdayPolicy>
+    ParseResult parse(std::string_view stamp) noexcept;
+
+    extern template ParseResult parse<LenientWeekday>(std::string_view stamp) noexcept;
+    extern template ParseResult parse<StrictWeekday>(std::string_view stamp) noexcept;
+
+    // Caller-owned structure-of-arrays destination for parseBatch().
+    // Element i of each array receives the result for stamp i. Stamps that fail to parse get a
+    // time of the epoch and a differential of 0, so the arrays can be consumed without branching.
+    struct BatchOutput
+    {
+        std::chrono::system_clock::time_point* time = nullptr; // required: one per stamp, in UTC
+        std::int16_t* timeZoneDifferential = nullptr;          // optional: one per stamp, in minutes
+        std::uint8_t* valid = nullptr;                         // optional: bitmap of (count + 7) / 8 bytes; bit (i % 8) of byte (i / 8) is set if stamp i parsed
+    };
+
+    // Parse count stamps as parse() does and write the results into out.
+    // Returns the number of stamps that parsed.
+    std::size_t parseBatch(const std::string_view* stamps, std::size_t count, const BatchOutput& out) noexcept;
+
+#ifdef RFC882_HAS_SPAN
+    // What a span overload of parseBatch() handled. Only the stamps that fit in time (and in valid and
+    // timeZoneDifferential, if they are non-empty) are parsed, so processed is less than stamps.size() when
+    // an output is shorter than the stamps.
+    struct BatchCount
+    {
+        std::size_t processed = 0;  // From the first stamp; the outputs past them are left alone
+        std::size_t parsed = 0;     // The processed stamps that parsed
+    };
+
+    namespace detail
+    {
+        // The number of stamps that fit in the outputs
+        inline std::size_t batchFit(std::size_t stamps, std::size_t time, std::size_t valid, std::size_t timeZoneDifferential) noexcept
+        {
+            std::size_t count = std::min(stamps, time);
+            if(valid != 0)
+                count = std::min(count, valid * 8);
+            if(timeZoneDifferential != 0)
+                count = std::min(count, timeZoneDifferential);
+            return count;
+        }
+    }
+
+    inline BatchCount parseBatch(std::span<const std::string_view> stamps,
+        std::span<std::chrono::system_clock::time_point> time,
+        std::span<std::uint8_t> valid = {},
+        std::span<std::int16_t> timeZoneDifferential = {}) noexcept
+    {
+        const std::size_t count = detail::batchFit(stamps.size(), time.size(), valid.size(), timeZoneDifferential.size());
+        return { count, parseBatch(stamps.data(), count, BatchOutput{ time.data(),
+            timeZoneDifferential.empty() ? nullptr : timeZoneDifferential.data(),
+            valid.empty() ? nullptr : valid.data() }) };
+    }
+#endif
+
+    // Take an RFC882 Date and Time and try to parse it into an RFC882DateTime structure.
+    std::optional<RFC882DateTime> parseDateAndTimeSpec(std::string stamp);
+
+    // parseDateAndTimeSpec() with the given weekday policy; see parse<WeekdayPolicy>().
+    template <class WeekdayPolicy>
+    std::optional<RFC882DateTime> parseDateAndTimeSpec(std::string stamp);
+
+    // Copy the tokens of a parsed stamp into an RFC882DateTime structure.
+    // result must come from parsing stamp. Returns std::nullopt if result isn't valid.
+    std::optional<RFC882DateTime> toDateTime(std::string stamp, const ParseResult& result);
+
+    template <class WeekdayPolicy>
+    std::optional<RFC882DateTime> parseDateAndTimeSpec(std::string stamp)
+    {
+        const ParseResult result = parse<WeekdayPolicy>(stamp);
+        return toDateTime(std::move(stamp), result);
+    }
+
+    // Same as parseDateAndTimeSpec(), but implemented with std::regex.
+    // This is much slower and is kept as the reference implementation for differential testing.
+    std::optional<RFC882DateTime> parseDateAndTimeSpecRegex(std::string stamp);
+
+    // Comparison operators. In C++20, these can be replaced by overloading <=>.
+    inline bool operator<(const RFC882DateTime& x, const RFC882DateTime& y)
+    {
+        return x.time < y.time;
+    }
+
+    inline bool operator<=(const RFC882DateTime& x, const RFC882DateTime& y)
+    {
+        return x.time <= y.time;
+    }
+
+    inline bool operator>(const RFC882DateTime& x, const RFC882DateTime& y)
+    {
+        return x.time > y.time;
+    }
+
+    inline bool operator>=(const RFC882DateTime& x, const RFC882DateTime& y)
+    {
+        return x.time >= y.time;
+    }
+
+    inline bool operator==(const RFC882DateTime& x, const RFC882DateTime& y)
+    {
+        return x.time == y.time;
+    }
+}
+
+#endif
@@ -0,0 +1,134 @@
+#include "rfc882find.h"
+#include "rfc882scanner.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        using detail::isAsciiLetter;
+        using detail::isDigit;
+        using detail::isSpace;
+
+        constexpr bool isAlphanumeric(char c) noexcept
+        {
+            return isDigit(c) || isAsciiLetter(c);
+        }
+
+        // The start of the run of whitespace that ends at end, going back no further than limit
+        constexpr std::size_t skipSpacesBack(std::string_view text, std::size_t end, std::size_t limit) noexcept
+        {
+            while(end > limit && isSpace(text[end - 1]))
+                --end;
+            return end;
+        }
+
+        // The start of the run of at most maxDigits digits that ends at end, going back no further than limit
+        constexpr std::size_t skipDigitsBack(std::string_view text, std::size_t end, std::size_t limit, std::size_t maxDigits) noexcept
+        {
+            const std::size_t last = end;
+            while(end > limit && last - end < maxDigits && isDigit(text[end - 1]))
+                --end;
+            return end;
+        }
+
+        // Match the shape of a stamp around the ':' of its time at colon, starting at limit or later.
+        // The match is loose (the names, calendar and zone are left to parse()), but never cuts a stamp short.
+        constexpr bool matchAround(std::string_view text, std::size_t colon, std::size_t limit, std::size_t& begin, std::size_t& end) noexcept
+        {
+            // HH:MM
+            if(colon < limit + 2 || text.size() - colon < 3)
+                return false;
+            const std::size_t hour = colon - 2;
+            if(!isDigit(text[hour]) || !isDigit(text[hour + 1]) || !isDigit(text[colon + 1]) || !isDigit(text[colon + 2]))
+                return false;
+
+            // Backwards from the hour: day \s+ month \s+ year \s+
+            const std::size_t yearEnd = skipSpacesBack(text, hour, limit);
+            const std::size_t yearBegin = skipDigitsBack(text, yearEnd, limit, 4);
+            if(yearEnd == hour || yearEnd - yearBegin < 2 || (yearBegin > limit && isDigit(text[yearBegin - 1])))
+                return false;
+
+            const std::size_t monthEnd = skipSpacesBack(text, yearBegin, limit);
+            if(monthEnd == yearBegin || monthEnd - limit < 3 || monthFromName(text.substr(monthEnd - 3, 3)) == 0)
+                return false;
+
+            const std::size_t dayEnd = skipSpacesBack(text, monthEnd - 3, limit);
+            const std::size_t dayBegin = skipDigitsBack(text, dayEnd, limit, 2);
+            if(dayEnd == monthEnd - 3 || dayBegin == dayEnd)
+                return false;
+
+            // [ day "," ] \s*, if the day of week starts a word
+            const std::size_t weekdayEnd = skipSpacesBack(text, dayBegin, limit);
+            if(weekdayEnd - limit >= 4 && text[weekdayEnd - 1] == ',' && weekdayFromName(text.substr(weekdayEnd - 4, 3)) >= 0 &&
+                (weekdayEnd == 4 || !isAlphanumeric(text[weekdayEnd - 5])))
+                begin = weekdayEnd - 4;
+            else if(dayBegin != 0 && isAlphanumeric(text[dayBegin - 1]))
+                return false;
+            else
+                begin = dayBegin;
+
+            // Forwards from the minute: [":" 2DIGIT] \s+ zone
+            std::size_t pos = colon + 3;
+            if(pos < text.size() && text[pos] == ':')
+            {
+                if(text.size() - pos < 3 || !isDigit(text[pos + 1]) || !isDigit(text[pos + 2]))
+                    return false;
+                pos += 3;
+            }
+
+            const std::size_t zoneBegin = pos;
+            detail::skipSpaces(text, pos);
+            if(pos == zoneBegin)
+                return false;
+
+            const std::size_t zone = pos;
+            if(pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
+            {
+                ++pos;
+                while(pos < text.size() && pos - zone <= 4 && isDigit(text[pos]))
+                    ++pos;
+            }
+            else
+            {
+                while(pos < text.size() && isAsciiLetter(text[pos]))
+                    ++pos;
+            }
+            if(pos == zone || (pos < text.size() && isAlphanumeric(text[pos])))
+                return false;
+
+            end = pos;
+            return true;
+        }
+    }
+
+    bool findStamp(std::string_view text, std::size_t pos, FoundStamp& found) noexcept
+    {
+        // std::string_view::find() is memchr(), which skips the text between the ':' many bytes at a time
+        for(std::size_t colon = text.find(':', pos); colon != std::string_view::npos; colon = text.find(':', colon + 1))
+        {
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            if(!matchAround(text, colon, pos, begin, end))
+                continue;
+
+            const std::string_view stamp = text.substr(begin, end - begin);
+            const ParseResult result = parse(stamp);
+            if(result)
+            {
+                found.offset = begin;
+                found.stamp = stamp;
+                found.result = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<FoundStamp> findAll(std::string_view text)
+    {
+        std::vector<FoundStamp> stamps;
+        findAll(text, [&stamps](const FoundStamp& found) { stamps.push_back(found); });
+        return stamps;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef RFC882FIND_H
+#define RFC882FIND_H
+
+/*
+Extraction of the stamps inside larger text, such as whole mail headers, HTML or log files, in one pass:
+
+    rfc882::findAll(headers, [](const rfc882::FoundStamp& found) {
+        use(found.offset, found.result.time);
+    });
+
+The scan is anchored on ':', which every stamp has between its hour and minute, so most of the text is
+skipped by memchr(). Around each ':' the shape of a stamp is matched backwards to the day (and day of
+week) and forwards to the zone, and the candidate is then parsed by parse(). Only the stamps that parse
+are reported, with the result that parse() returns for them.
+
+A stamp must not be preceded or followed by a letter or digit, so that "Tue, 7 Oct 2014 10:10 GMTX" or
+the tail of "123 Oct 2014 10:10 GMT" aren't taken. A day of week that doesn't fit is left out of the
+stamp, and the stamp starts at the day instead. The whitespace inside a stamp follows the grammar, so
+stamps can span lines in folded mail headers.
+*/
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    struct FoundStamp
+    {
+        std::size_t offset = 0;     // Of the stamp in the text
+        std::string_view stamp;     // The stamp itself, within the text
+        ParseResult result;         // What parse() returns for stamp, so the tokens are relative to it
+    };
+
+    // Find the first stamp that starts at or after pos in text. Returns false if there is none.
+    bool findStamp(std::string_view text, std::size_t pos, FoundStamp& found) noexcept;
+
+    // Call onStamp(const FoundStamp&) for every stamp of text, in order. Returns the number of stamps.
+    template <class Callback>
+    std::size_t findAll(std::string_view text, Callback&& onStamp)
+    {
+        std::size_t count = 0;
+        FoundStamp found;
+        for(std::size_t pos = 0; findStamp(text, pos, found); pos = found.offset + found.stamp.size())
+        {
+            onStamp(static_cast<const FoundStamp&>(found));
+            ++count;
+        }
+        return count;
+    }
+
+    // Every stamp of text, in order.
+    std::vector<FoundStamp> findAll(std::string_view text);
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include <algorithm> // for std::clamp()
+#include <array>
+#include <cstring> // for std::memcpy()
+
+#include "rfc882calendar.h"
+#include "rfc882format.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        // "00" "01" ... "99", so that two digits are a single copy
+        constexpr std::array<char, 200> makeDigitPairs() noexcept
+        {
+            std::array<char, 200> pairs{};
+            for(std::size_t i = 0; i < 100; ++i)
+            {
+                pairs[2 * i] = static_cast<char>('0' + i / 10);
+                pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+            }
+            return pairs;
+        }
+
+        constexpr std::array<char, 200> digitPairs = makeDigitPairs();
+
+        char* writePair(char* out, unsigned value) noexcept
+        {
+            std::memcpy(out, &digitPairs[2 * value], 2);
+            return out + 2;
+        }
+
+        char* writeName(char* out, std::string_view name) noexcept
+        {
+            std::memcpy(out, name.data(), 3);
+            return out + 3;
+        }
+    }
+
+    char* format(std::chrono::system_clock::time_point time, std::chrono::minutes differential, char* out) noexcept
+    {
+        // The parser takes any 4 digits, so "+9999" is 100:39 and has no HHMM form. Clamping keeps the time right.
+        differential = std::clamp(differential, -maxFormattedDifferential, maxFormattedDifferential);
+
+        // Local time of day and day number, rounding towards negative infinity before the epoch
+        const std::int64_t local = std::chrono::floor<std::chrono::seconds>(time + differential).time_since_epoch().count();
+        std::int64_t days = local / 86400;
+        std::int64_t secondsOfDay = local % 86400;
+        if(secondsOfDay < 0)
+        {
+            secondsOfDay += 86400;
+            --days;
+        }
+
+        const auto date = civil_from_days(days);
+        const auto year = static_cast<unsigned>(date.y);
+        const auto seconds = static_cast<unsigned>(secondsOfDay);
+
+        out = writeName(out, weekdayName(static_cast<int>(weekday_from_days(days))));
+        *out++ = ',';
+        *out++ = ' ';
+        out = writePair(out, date.d);
+        *out++ = ' ';
+        out = writeName(out, monthName(static_cast<int>(date.m)));
+        *out++ = ' ';
+        out = writePair(out, year / 100 % 100);
+        out = writePair(out, year % 100);
+        *out++ = ' ';
+        out = writePair(out, seconds / 3600);
+        *out++ = ':';
+        out = writePair(out, seconds / 60 % 60);
+        *out++ = ':';
+        out = writePair(out, seconds % 60);
+        *out++ = ' ';
+
+        const auto zone = differential.count();
+        const auto zoneMinutes = static_cast<unsigned>(zone < 0 ? -zone : zone);
+        *out++ = zone < 0 ? '-' : '+';
+        out = writePair(out, zoneMinutes / 60);
+        return writePair(out, zoneMinutes % 60);
+    }
+
+    char* formatBatch(const std::chrono::system_clock::time_point* times, const std::int16_t* differentials, std::size_t count, char* out) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            out = format(times[i], std::chrono::minutes{ differentials ? differentials[i] : 0 }, out);
+        return out;
+    }
+}
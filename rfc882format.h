@@ -0,0 +1,68 @@
+#ifndef RFC882FORMAT_H
+#define RFC882FORMAT_H
+
+/*
+Format time points as canonical RFC882 stamps:
+
+    Ddd, DD Mon YYYY HH:MM:SS +HHMM
+
+The output always has formattedSize characters. It is written into a caller-provided buffer,
+is not null-terminated, and doesn't depend on the C locale or strftime().
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    constexpr std::size_t formattedSize = 31;
+
+    // The largest differential that +HHMM can write: +99:59
+    constexpr std::chrono::minutes maxFormattedDifferential{ 99 * 60 + 59 };
+
+    // Write time, as seen from the time zone with the given differential, into out.
+    // out must have room for formattedSize characters. Returns a pointer past the last character written.
+    // Differentials beyond +/-99:59 are clamped to it, so the stamp is then at the same time in another zone.
+    // Preconditions: time + differential is representable and its year is in [0, 9999]; other years are
+    //                written modulo 10000.
+    char* format(std::chrono::system_clock::time_point time, std::chrono::minutes differential, char* out) noexcept;
+
+    // Write the stamp for a parsed date, using its original time zone differential. Parsed differentials
+    // with more than 59 minutes, such as "+9999", are beyond +/-99:59 from 100 hours on, and are clamped.
+    inline char* format(const RFC882DateTime& date, char* out) noexcept
+    {
+        return format(date.time, date.dateTime.timeZoneDifferential, out);
+    }
+
+    // Convenience overload that allocates.
+    inline std::string format(std::chrono::system_clock::time_point time, std::chrono::minutes differential = {})
+    {
+        std::string stamp(formattedSize, '\0');
+        format(time, differential, stamp.data());
+        return stamp;
+    }
+
+    // Format count time points back to back into out, which must have room for count * formattedSize characters.
+    // differentials (in minutes, as written by parseBatch()) may be null to format everything in UT.
+    // Returns a pointer past the last character written.
+    char* formatBatch(const std::chrono::system_clock::time_point* times, const std::int16_t* differentials, std::size_t count, char* out) noexcept;
+
+#ifdef RFC882_HAS_SPAN
+    // Time points that don't fit in out are not formatted.
+    inline char* formatBatch(std::span<const std::chrono::system_clock::time_point> times, std::span<char> out,
+        std::span<const std::int16_t> differentials = {}) noexcept
+    {
+        std::size_t count = std::min(times.size(), out.size() / formattedSize);
+        if(!differentials.empty())
+            count = std::min(count, differentials.size());
+
+        return formatBatch(times.data(), differentials.empty() ? nullptr : differentials.data(), count, out.data());
+    }
+#endif
+}
+
+#endif
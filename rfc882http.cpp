@@ -0,0 +1,218 @@
+#include <cstdint>
+
+#include "rfc882calendar.h"
+#include "rfc882http.h"
+#include "rfc882scanner.h"
+#include "rfc882simd.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        // The bytes after the day name of each form. The lower-case letters stand for the fields: d(ay), b (month,
+        // as in strftime()), y(ear), h(our), i (minute) and s(econd); '_' is a digit or the space that pads the day
+        // of asctime(). Every other byte must be there as it is.
+        constexpr std::string_view imfFixdatePattern = ", dd bbb yyyy hh:ii:ss GMT";
+        constexpr std::string_view rfc850Pattern = ", dd-bbb-yy hh:ii:ss GMT";
+        constexpr std::string_view asctimePattern = " bbb _d hh:ii:ss yyyy";
+
+        static_assert(imfFixdatePattern.size() + 3 == detail::fixedLayoutNamedSize, "IMF-fixdate is the named fixed layout");
+
+        constexpr std::string_view longWeekdayNames[] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+
+        // The field that a byte of a pattern belongs to. Separators belong to none, so their errors are those of the field before them.
+        struct PatternField
+        {
+            TokenSpan* token = nullptr;
+            int* value = nullptr;           // For the digits
+            ParseError error = ParseError::none;
+        };
+
+        constexpr PatternField patternField(char field, ParseResult& out) noexcept
+        {
+            switch(field)
+            {
+            case 'd': case '_': return { &out.tokens.day, &out.dateTime.day, ParseError::badDay };
+            case 'b': return { &out.tokens.month, nullptr, ParseError::badMonth };
+            case 'y': return { &out.tokens.year, &out.dateTime.year, ParseError::badYear };
+            case 'h': return { &out.tokens.hour, &out.dateTime.hour, ParseError::badTime };
+            case 'i': return { &out.tokens.minute, &out.dateTime.minute, ParseError::badTime };
+            case 's': return { &out.tokens.second, &out.dateTime.second, ParseError::badTime };
+            case 'G': case 'M': case 'T': return { &out.tokens.timeZone, nullptr, ParseError::badZone };
+            default: return {};
+            }
+        }
+
+        // Decode the bytes of stamp after the day name, which ends at weekdayEnd, into out.tokens and out.dateTime
+        // as pattern says, with the year as it is written. Returns false with the error set if they don't fit.
+        constexpr bool decode(std::string_view stamp, std::size_t weekdayEnd, std::string_view pattern, ParseResult& out) noexcept
+        {
+            out.tokens.dayOfWeek = { 0, static_cast<std::uint32_t>(weekdayEnd) };
+            out.dateTime.day = out.dateTime.year = out.dateTime.hour = out.dateTime.minute = out.dateTime.second = 0;
+
+            ParseError error = ParseError::badWeekday;
+            std::size_t errorOffset = weekdayEnd;
+            for(std::size_t i = 0; i < pattern.size(); ++i)
+            {
+                const std::size_t pos = weekdayEnd + i;
+                const PatternField field = patternField(pattern[i], out);
+                if(field.error != ParseError::none && field.error != error)
+                {
+                    // The zone is reported at its start, the other fields where they fail
+                    error = field.error;
+                    errorOffset = pos;
+                }
+                if(pos >= stamp.size())
+                    return detail::fail(out, error, error == ParseError::badZone ? errorOffset : pos);
+
+                const char c = stamp[pos];
+                if(field.value)
+                {
+                    if(pattern[i] == '_' && c == ' ')
+                        continue;
+                    if(!detail::isDigit(c))
+                        return detail::fail(out, error, pos);
+                    *field.value = *field.value * 10 + (c - '0');
+                }
+                else if(pattern[i] != 'b' && c != pattern[i])
+                {
+                    return detail::fail(out, error, error == ParseError::badZone ? errorOffset : pos);
+                }
+
+                if(field.token)
+                {
+                    if(field.token->length == 0)
+                        field.token->offset = static_cast<std::uint32_t>(pos);
+                    ++field.token->length;
+                }
+            }
+            if(stamp.size() != weekdayEnd + pattern.size())
+                return detail::fail(out, error, error == ParseError::badZone ? errorOffset : weekdayEnd + pattern.size());
+
+            if((out.dateTime.month = monthFromName(token(stamp, out.tokens.month))) == 0)
+                return detail::fail(out, ParseError::badMonth, out.tokens.month.offset);
+            out.dateTime.timeZoneDifferential = std::chrono::minutes{ 0 };
+            return true;
+        }
+
+        // The day names of IMF-fixdate and asctime()
+        constexpr bool checkShortWeekday(std::string_view stamp, ParseResult& out) noexcept
+        {
+            return weekdayFromName(stamp.substr(0, 3)) >= 0 || detail::fail(out, ParseError::badWeekday, 0);
+        }
+
+        // IMF-fixdate with the fixed-layout kernel. Returns false without touching out if anything doesn't fit;
+        // decode() then finds what.
+        bool scanImfFixdate(std::string_view stamp, ParseResult& out) noexcept
+        {
+            std::uint8_t pairs[8];
+            if(stamp.size() != detail::fixedLayoutNamedSize || stamp.substr(26) != "GMT" || !detail::fixedLayoutKernel()(stamp.data(), false, pairs))
+                return false;
+
+            RFC882DateTime::DateTime dateTime;
+            if(weekdayFromName(stamp.substr(0, 3)) < 0 || (dateTime.month = monthFromName(stamp.substr(8, 3))) == 0)
+                return false;
+
+            dateTime.day = pairs[0];
+            dateTime.year = pairs[1] * 100 + pairs[2];
+            dateTime.hour = pairs[3];
+            dateTime.minute = pairs[4];
+            dateTime.second = pairs[5];
+            dateTime.timeZoneDifferential = std::chrono::minutes{ 0 };
+
+            out.dateTime = dateTime;
+            out.tokens.dayOfWeek = { 0, 3 };
+            out.tokens.day = { 5, 2 };
+            out.tokens.month = { 8, 3 };
+            out.tokens.year = { 12, 4 };
+            out.tokens.hour = { 17, 2 };
+            out.tokens.minute = { 20, 2 };
+            out.tokens.second = { 23, 2 };
+            out.tokens.timeZone = { 26, 3 };
+            return true;
+        }
+
+        // The year of an RFC 850 stamp: at most 50 years after the year of now (RFC 9110 section 5.6.7)
+        int expandRfc850Year(int year, const std::chrono::system_clock::time_point* now) noexcept
+        {
+            using days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+            const days today = std::chrono::floor<days>((now ? *now : std::chrono::system_clock::now()).time_since_epoch());
+            const int currentYear = static_cast<int>(civil_from_days(today.count()).y);
+
+            const int expanded = currentYear - currentYear % 100 + year;
+            return (expanded > currentYear + 50) ? expanded - 100 : expanded;
+        }
+
+        // Check the decoded stamp and compute its time, as parse() does
+        ParseResult convert(ParseResult& result) noexcept
+        {
+            std::int64_t daysFromEpoch = 0;
+            if(!detail::checkBounds(result, daysFromEpoch))
+                return detail::rejection(result);
+
+            result.time = generateUTCTime(result.dateTime, daysFromEpoch);
+            result.valid = true;
+            return result;
+        }
+
+        ParseResult decodeImfFixdate(std::string_view stamp, ParseResult& result) noexcept
+        {
+            if(!scanImfFixdate(stamp, result) && (!checkShortWeekday(stamp, result) || !decode(stamp, 3, imfFixdatePattern, result)))
+                return detail::rejection(result);
+            return convert(result);
+        }
+
+        ParseResult decodeAsctime(std::string_view stamp, ParseResult& result) noexcept
+        {
+            if(!checkShortWeekday(stamp, result) || !decode(stamp, 3, asctimePattern, result))
+                return detail::rejection(result);
+            result.tokens.timeZone = {}; // asctime() has no zone; the time is in UTC
+            return convert(result);
+        }
+
+        ParseResult decodeRfc850(std::string_view stamp, const std::chrono::system_clock::time_point* now, ParseResult& result) noexcept
+        {
+            // Without a comma, the whole stamp could still be a day name, and decode() would start past its end
+            const std::size_t weekdayEnd = stamp.find(',');
+            const int weekday = weekdayFromName(stamp.substr(0, 3));
+            if(weekdayEnd == std::string_view::npos || weekday < 0 || stamp.substr(0, weekdayEnd) != longWeekdayNames[weekday])
+            {
+                detail::fail(result, ParseError::badWeekday, 0);
+                return detail::rejection(result);
+            }
+
+            if(!decode(stamp, weekdayEnd, rfc850Pattern, result))
+                return detail::rejection(result);
+            result.dateTime.year = expandRfc850Year(result.dateTime.year, now);
+            return convert(result);
+        }
+
+        ParseResult decodeHttpDate(std::string_view stamp, const std::chrono::system_clock::time_point* now) noexcept
+        {
+            // The forms differ right after the day name: "," in IMF-fixdate, " " in asctime() and a longer name in RFC 850
+            ParseResult result;
+            if(stamp.size() > 3 && stamp[3] == ',')
+                return decodeImfFixdate(stamp, result);
+            if(stamp.size() > 3 && stamp[3] == ' ')
+                return decodeAsctime(stamp, result);
+            return decodeRfc850(stamp, now, result);
+        }
+    }
+
+    ParseResult parseHttpDate(std::string_view stamp) noexcept
+    {
+        return decodeHttpDate(stamp, nullptr);
+    }
+
+    ParseResult parseHttpDate(std::string_view stamp, std::chrono::system_clock::time_point now) noexcept
+    {
+        return decodeHttpDate(stamp, &now);
+    }
+
+    ParseResult parseImfFixdate(std::string_view stamp) noexcept
+    {
+        ParseResult result;
+        return decodeImfFixdate(stamp, result);
+    }
+}
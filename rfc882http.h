@@ -0,0 +1,42 @@
+#ifndef RFC882HTTP_H
+#define RFC882HTTP_H
+
+/*
+HTTP-date (RFC 9110 section 5.6.7, formerly RFC 7231 section 7.1.1.1), as found in the Date, Expires,
+Last-Modified and If-Modified-Since headers. Senders must use IMF-fixdate, but recipients must also
+accept the two obsolete forms:
+
+    Sun, 06 Nov 1994 08:49:37 GMT       IMF-fixdate, always 29 bytes
+    Sunday, 06-Nov-94 08:49:37 GMT      RFC 850, with the full name of the day and a 2-digit year
+    Sun Nov  6 08:49:37 1994            asctime(), in UTC, with a space-padded day
+
+Every field is at a fixed offset from the end of the day name, so the forms are decoded without
+scanning: IMF-fixdate with the vectorized kernel of the fixed-layout fast path (rfc882simd.h), and the
+obsolete forms with one compare per byte. There is no whitespace to skip, the names are case-sensitive
+and the zone is always GMT. The dates and times are checked and converted by the calendar core of
+parse(), so leap seconds (":60") are rejected as outOfRange as they are there.
+
+The results follow the conventions of parse(), including the errors. The day of week isn't checked
+against the date, and the tokens of asctime stamps have no zone. 4-digit years are taken as they are.
+An RFC 850 year is the one with those last two digits that is at most 50 years after the year of now,
+as RFC 9110 requires; the overload without now calls system_clock::now() for RFC 850 stamps only.
+
+For RFC 2822 and 5322 stamps, see Rfc5322Dialect in rfc882parser.h.
+*/
+
+#include <chrono>
+#include <string_view>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    // Any of the three forms.
+    ParseResult parseHttpDate(std::string_view stamp) noexcept;
+    ParseResult parseHttpDate(std::string_view stamp, std::chrono::system_clock::time_point now) noexcept;
+
+    // IMF-fixdate only, for the headers that must be in the preferred form.
+    ParseResult parseImfFixdate(std::string_view stamp) noexcept;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef RFC882INLINE_H
+#define RFC882INLINE_H
+
+/*
+parse() defined in the header, for hot loops that should have the scanner and calendar code inlined at
+the call site instead of calling into the library:
+
+    for(std::string_view stamp : stamps)
+        total += rfc882::parseInline(stamp).time.time_since_epoch().count();
+
+parseInline() is what parse() runs, without the statistics (rfc882stats.h), so the results are the same.
+The vectorized fast path stays in the library, behind the kernel picked at run time (rfc882simd.h). Code
+that can't link the library can use parseConstexpr() (rfc882literal.h) or BasicParser (rfc882parser.h),
+which only need the headers and always take the scanner.
+
+Link-time optimization (see the RFC882_LTO option of the CMake build) inlines parse() itself across
+translation units as well.
+*/
+
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882calendar.h"
+#include "rfc882datetime.h"
+#include "rfc882scanner.h"
+#include "rfc882simd.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    namespace detail
+    {
+        // parse() without the statistics. fixedLayout is set if the fast path took the stamp.
+        template <class WeekdayPolicy>
+        ParseResult parseStamp(std::string_view stamp, bool& fixedLayout) noexcept
+        {
+            // Most stamps have one of the fixed layouts handled by the vectorized fast path.
+            // Everything else goes through the scanner.
+            ParseResult result;
+            fixedLayout = scanFixedLayout(stamp, result);
+            if(!fixedLayout && !scanDateAndTimeSpec(stamp, result))
+                return rejection(result); // The timestamp is not RFC882 compliant
+
+            // Make sure that the date and time are not out of normal bounds, and count the days in the same pass.
+            std::int64_t daysFromEpoch = 0;
+            if(!checkBounds(result, daysFromEpoch))
+                return rejection(result);
+
+            if constexpr(WeekdayPolicy::checkWeekday)
+            {
+                const int weekday = result.tokens.dayOfWeek.length ? weekdayFromName(token(stamp, result.tokens.dayOfWeek)) : -1;
+                if(!checkWeekday(result, weekday, daysFromEpoch))
+                    return rejection(result);
+            }
+
+            result.time = generateUTCTime(result.dateTime, daysFromEpoch);
+            result.valid = true;
+            return result;
+        }
+    }
+
+    // Same as parse<WeekdayPolicy>(stamp), inlined at the call site.
+    template <class WeekdayPolicy = LenientWeekday>
+    ParseResult parseInline(std::string_view stamp) noexcept
+    {
+        bool fixedLayout = false;
+        return detail::parseStamp<WeekdayPolicy>(stamp, fixedLayout);
+    }
+}
+
+#endif
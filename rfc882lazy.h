@@ -0,0 +1,122 @@
+#ifndef RFC882LAZY_H
+#define RFC882LAZY_H
+
+/*
+LazyDateTime is the counterpart of RFC882DateTime for callers that mostly read the time.
+It keeps the stamp and the token offsets found by parse(), and only copies the tokens into
+std::string objects when tokens() is first called. The string_view accessors never copy.
+
+    if(auto date = rfc882::parseDateAndTimeSpecLazy(stamp))
+    {
+        use(date->time());
+        if(date->timeZone() == "PST") ...            // no copy
+        const auto& tokens = date->tokens();        // copied here, once
+    }
+
+tokens() fills a cache, so unlike the other accessors it must not be called on the same object
+from several threads at once.
+*/
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility> // for std::move()
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    class LazyDateTime
+    {
+    public:
+        // result must come from parsing stamp and be valid
+        LazyDateTime(std::string stamp, const ParseResult& result) : stamp_{ std::move(stamp) }, result_{ result } {}
+
+        const std::string& stamp() const noexcept { return stamp_; }
+        std::chrono::system_clock::time_point time() const noexcept { return result_.time; }
+        const RFC882DateTime::DateTime& dateTime() const noexcept { return result_.dateTime; }
+        const ParseResult& result() const noexcept { return result_; }
+
+        // The tokens as views into stamp(), without copying. Absent optional tokens are empty.
+        std::string_view dayOfWeek() const noexcept { return token(stamp_, result_.tokens.dayOfWeek); }
+        std::string_view day() const noexcept { return token(stamp_, result_.tokens.day); }
+        std::string_view month() const noexcept { return token(stamp_, result_.tokens.month); }
+        std::string_view year() const noexcept { return token(stamp_, result_.tokens.year); }
+        std::string_view hour() const noexcept { return token(stamp_, result_.tokens.hour); }
+        std::string_view minute() const noexcept { return token(stamp_, result_.tokens.minute); }
+        std::string_view second() const noexcept { return token(stamp_, result_.tokens.second); }
+        std::string_view timeZone() const noexcept { return token(stamp_, result_.tokens.timeZone); }
+
+        // The tokens as in RFC882DateTime, copied on first use.
+        const RFC882DateTime::Tokens& tokens() const
+        {
+            if(!tokens_)
+            {
+                tokens_.emplace();
+                tokens_->dayOfWeek = dayOfWeek();
+                tokens_->day = day();
+                tokens_->month = month();
+                tokens_->year = year();
+                tokens_->hour = hour();
+                tokens_->minute = minute();
+                tokens_->second = second();
+                tokens_->timeZone = timeZone();
+            }
+            return *tokens_;
+        }
+
+        // The equivalent RFC882DateTime, for code that takes one.
+        RFC882DateTime toDateTime() const
+        {
+            RFC882DateTime date;
+            date.stamp = stamp_;
+            date.time = result_.time;
+            date.tokens = tokens();
+            date.dateTime = result_.dateTime;
+            return date;
+        }
+
+    private:
+        std::string stamp_;
+        ParseResult result_;
+        mutable std::optional<RFC882DateTime::Tokens> tokens_;
+    };
+
+    // Same as parseDateAndTimeSpec(), but the tokens aren't copied until they're asked for.
+    inline std::optional<LazyDateTime> parseDateAndTimeSpecLazy(std::string stamp)
+    {
+        const ParseResult result = parse(stamp);
+        if(!result)
+            return std::nullopt;
+        return LazyDateTime{ std::move(stamp), result };
+    }
+
+    // Comparison operators, by time as for RFC882DateTime.
+    inline bool operator<(const LazyDateTime& x, const LazyDateTime& y)
+    {
+        return x.time() < y.time();
+    }
+
+    inline bool operator<=(const LazyDateTime& x, const LazyDateTime& y)
+    {
+        return x.time() <= y.time();
+    }
+
+    inline bool operator>(const LazyDateTime& x, const LazyDateTime& y)
+    {
+        return x.time() > y.time();
+    }
+
+    inline bool operator>=(const LazyDateTime& x, const LazyDateTime& y)
+    {
+        return x.time() >= y.time();
+    }
+
+    inline bool operator==(const LazyDateTime& x, const LazyDateTime& y)
+    {
+        return x.time() == y.time();
+    }
+}
+
+#endif
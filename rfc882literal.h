@@ -0,0 +1,77 @@
+#ifndef RFC882LITERAL_H
+#define RFC882LITERAL_H
+
+/*
+Compile-time parsing of stamps, for dates that are fixed in the source:
+
+    using namespace rfc882::literals;
+    constexpr auto released = "Tue, 7 Oct 2014 10:10:05 PST"_rfc882;        // std::chrono::system_clock::time_point
+
+    template <std::int64_t Epoch> struct Expiry {};
+    Expiry<rfc882::epochSeconds("Mon, 1 Jan 2024 00:00:00 GMT")> expiry;
+
+A malformed stamp doesn't compile. In C++20 the literal is consteval, so this holds everywhere; in C++17
+it holds in constant expressions, and the literal throws std::invalid_argument when evaluated at run time.
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include "rfc882calendar.h"
+#include "rfc882datetime.h"
+#include "rfc882scanner.h"
+
+#if defined(__cpp_consteval) && __cpp_consteval >= 201811L
+#define RFC882_CONSTEVAL consteval
+#else
+#define RFC882_CONSTEVAL constexpr
+#endif
+
+namespace rfc882
+{
+    // Same as parse(), but usable in constant expressions. It always takes the scanner
+    // instead of the vectorized fast path, which gives the same results.
+    constexpr ParseResult parseConstexpr(std::string_view stamp) noexcept
+    {
+        ParseResult result;
+        if(!detail::scanDateAndTimeSpec(stamp, result))
+            return detail::rejection(result); // The timestamp is not RFC882 compliant
+
+        if(!detail::checkBounds(result))
+            return detail::rejection(result);
+
+        result.time = generateUTCTime(result.dateTime);
+        result.valid = true;
+        return result;
+    }
+
+    // The UTC time of stamp. Throws std::invalid_argument if it doesn't parse,
+    // which is a compile error in a constant expression.
+    constexpr std::chrono::system_clock::time_point stampTime(std::string_view stamp)
+    {
+        const ParseResult result = parseConstexpr(stamp);
+        if(!result)
+            throw std::invalid_argument{ "Not an RFC882 date and time" };
+        return result.time;
+    }
+
+    // Seconds since 1970-01-01 UTC, for places that take integers but not time points,
+    // such as template arguments.
+    constexpr std::int64_t epochSeconds(std::string_view stamp)
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(stampTime(stamp).time_since_epoch()).count();
+    }
+
+    inline namespace literals
+    {
+        RFC882_CONSTEVAL std::chrono::system_clock::time_point operator""_rfc882(const char* stamp, std::size_t size)
+        {
+            return stampTime({ stamp, size });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "rfc882parallel.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        // The chunks a worker has left, on a cache line of its own
+        struct alignas(64) ChunkQueue
+        {
+            std::atomic<std::size_t> next{ 0 };
+            std::size_t end = 0;
+        };
+    }
+
+    std::size_t parseBatchParallel(const std::string_view* stamps, std::size_t count, const BatchOutput& out,
+        const ParallelOptions& options)
+    {
+        const std::size_t granularity = parallelChunkGranularity;
+        const std::size_t requested = std::min(options.chunkSize, count);
+        const std::size_t chunkSize = std::max(granularity, (requested + granularity - 1) / granularity * granularity);
+        const std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        if(chunkCount <= 1)
+            return parseBatch(stamps, count, out);
+
+        std::atomic<std::size_t> parsed{ 0 };
+        detail::runChunks(chunkCount, options.threads, [&](std::size_t chunk) {
+            // Chunks start on a multiple of 8, so each one owns whole bytes of the bitmap
+            const std::size_t begin = chunk * chunkSize;
+            const std::size_t size = std::min(chunkSize, count - begin);
+            const BatchOutput slice{ out.time + begin,
+                out.timeZoneDifferential ? out.timeZoneDifferential + begin : nullptr,
+                out.valid ? out.valid + begin / 8 : nullptr };
+            parsed.fetch_add(parseBatch(stamps + begin, size, slice), std::memory_order_relaxed);
+        });
+        return parsed.load(std::memory_order_relaxed);
+    }
+
+    namespace detail
+    {
+        void runChunks(std::size_t chunkCount, unsigned threads, const std::function<void(std::size_t chunk)>& task)
+        {
+            if(threads == 0)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            const unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threads, chunkCount));
+            if(workers <= 1)
+            {
+                for(std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+                    task(chunk);
+                return;
+            }
+
+            // Every worker starts with a contiguous run of chunks, which keeps its reads sequential
+            std::vector<ChunkQueue> queues(workers);
+            for(unsigned i = 0; i < workers; ++i)
+            {
+                queues[i].next.store(chunkCount * i / workers, std::memory_order_relaxed);
+                queues[i].end = chunkCount * (i + 1) / workers;
+            }
+
+            // Drain the worker's own queue, then steal from the others in turn
+            const auto work = [&queues, &task, workers](unsigned self) {
+                for(unsigned i = 0; i < workers; ++i)
+                {
+                    ChunkQueue& queue = queues[(self + i) % workers];
+                    for(std::size_t chunk; (chunk = queue.next.fetch_add(1, std::memory_order_relaxed)) < queue.end;)
+                        task(chunk);
+                }
+            };
+
+            // If a thread can't be started, the calling thread steals the chunks of the workers that are missing
+            std::vector<std::thread> pool;
+            pool.reserve(workers - 1);
+            for(unsigned i = 1; i < workers; ++i)
+            {
+                try
+                {
+                    pool.emplace_back(work, i);
+                }
+                catch(const std::system_error&)
+                {
+                    break;
+                }
+            }
+            work(0);
+            for(auto& thread : pool)
+                thread.join();
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef RFC882PARALLEL_H
+#define RFC882PARALLEL_H
+
+/*
+Multi-threaded batch parsing.
+
+The input is cut into chunks of stamps that are handed out to worker threads by a work-stealing
+scheduler. Each worker starts on its own contiguous run of chunks and, when it runs out, takes the
+remaining chunks of the other workers, so that slow chunks (long or malformed stamps) don't leave
+cores idle. Chunk sizes are multiples of parallelChunkGranularity, which keeps every chunk's slice
+of each output array on its own cache lines, so workers never write to the same line (no false sharing).
+
+Threads are started for each call, and the calling thread works as well. This pays off for inputs of
+at least some tens of thousands of stamps; smaller inputs are parsed on the calling thread.
+*/
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    // 512 stamps fill whole 64-byte lines of every BatchOutput array: 64 time points,
+    // 32 differentials and 8 bitmap bytes per line.
+    constexpr std::size_t parallelChunkGranularity = 512;
+
+    struct ParallelOptions
+    {
+        unsigned threads = 0;           // 0 uses std::thread::hardware_concurrency()
+        std::size_t chunkSize = 4096;   // stamps per chunk, rounded up to a multiple of parallelChunkGranularity
+    };
+
+    // Same as parseBatch(), using several threads. The output arrays should be 64-byte aligned
+    // for the chunks to be free of false sharing.
+    std::size_t parseBatchParallel(const std::string_view* stamps, std::size_t count, const BatchOutput& out,
+        const ParallelOptions& options = {});
+
+#ifdef RFC882_HAS_SPAN
+    // Only the stamps that fit in the outputs are parsed, as with the span overload of parseBatch().
+    inline BatchCount parseBatchParallel(std::span<const std::string_view> stamps,
+        std::span<std::chrono::system_clock::time_point> time,
+        std::span<std::uint8_t> valid = {},
+        std::span<std::int16_t> timeZoneDifferential = {},
+        const ParallelOptions& options = {})
+    {
+        const std::size_t count = detail::batchFit(stamps.size(), time.size(), valid.size(), timeZoneDifferential.size());
+        return { count, parseBatchParallel(stamps.data(), count, BatchOutput{ time.data(),
+            timeZoneDifferential.empty() ? nullptr : timeZoneDifferential.data(),
+            valid.empty() ? nullptr : valid.data() }, options) };
+    }
+#endif
+
+    namespace detail
+    {
+        // Run task(chunk) for every chunk in [0, chunkCount) on up to threads threads (0 for all cores),
+        // with the work-stealing scheduler described above. Returns once every chunk is done. If threads
+        // can't be started, the chunks are run on the others and the calling thread. task must not throw.
+        void runChunks(std::size_t chunkCount, unsigned threads, const std::function<void(std::size_t chunk)>& task);
+    }
+}
+
+#endif
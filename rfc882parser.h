@@ -0,0 +1,343 @@
+#ifndef RFC882PARSER_H
+#define RFC882PARSER_H
+
+/*
+Parsers specialized at compile time to a dialect of the date-time grammar, for ingestion paths that
+need other tolerances than parse():
+
+    using Parser = rfc882::BasicParser<rfc882::RssDialect>;
+    if(auto result = Parser::parse(stamp)) ...
+
+A dialect is a struct of compile-time settings. ReferenceDialect is the dialect of parse(), and the
+other ones (and your own) derive from it and redefine what differs:
+
+    struct FeedDialect : rfc882::ReferenceDialect
+    {
+        static constexpr bool caseInsensitive = true;
+        static constexpr rfc882::Whitespace whitespace = rfc882::Whitespace::lenient;
+    };
+
+Every setting is resolved with if constexpr, so each parser only contains the checks of its dialect.
+The results follow the conventions of parse(), including the errors. BasicParser always takes the
+scanner, so for the reference dialect parse() (which has the vectorized fast path) is faster.
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882calendar.h"
+#include "rfc882datetime.h"
+#include "rfc882scanner.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    enum class Whitespace : std::uint8_t
+    {
+        single,     // One ' ' wherever the grammar needs whitespace, and at most one after "Ddd,"
+        runs,       // Runs of ' ' and '\t' - '\r', as in the reference (\s+, and \s* after "Ddd,")
+        lenient     // runs, and also whitespace before and after the stamp
+    };
+
+    // Zone sets, for the Zones of a dialect. Numeric differentials are always accepted.
+    // find() gets names in upper case in case-insensitive dialects.
+    struct ReferenceZones
+    {
+        static constexpr bool find(std::string_view name, std::chrono::minutes& differential) noexcept
+        {
+            return timeZoneFromName(name, differential);
+        }
+    };
+
+    // All the military zones of RFC 822, which are the obsolete zones of RFC 2822 and 5322:
+    // A - I and K - M are -1 to -12 hours, N - Y are +1 to +12 hours and Z is UT. The other zones
+    // are the reference ones.
+    struct MilitaryZones
+    {
+        static constexpr bool find(std::string_view name, std::chrono::minutes& differential) noexcept
+        {
+            if(name.size() != 1 || name[0] < 'A' || name[0] > 'Z' || name[0] == 'J')
+                return timeZoneFromName(name, differential);
+
+            const char letter = name[0];
+            int hours = 0;
+            if(letter <= 'I')
+                hours = -(letter - 'A' + 1);
+            else if(letter <= 'M')
+                hours = -(letter - 'A'); // no J
+            else if(letter <= 'Y')
+                hours = letter - 'N' + 1;
+            differential = std::chrono::hours{ hours };
+            return true;
+        }
+    };
+
+    // The zones of Base, and then those of a NameTable of differentials in minutes (see makeNameTable()),
+    // which must be a constexpr variable:
+    //
+    //     inline constexpr auto ourZones = rfc882::makeNameTable<std::int16_t>({ { "CET", 60 }, { "CEST", 120 } });
+    //     struct OurDialect : rfc882::ReferenceDialect { using Zones = rfc882::TableZones<ourZones>; };
+    template <const auto& Table, class Base = ReferenceZones>
+    struct TableZones
+    {
+        static constexpr bool find(std::string_view name, std::chrono::minutes& differential) noexcept
+        {
+            if(Base::find(name, differential))
+                return true;
+            if(auto minutes = Table.find(name))
+            {
+                differential = std::chrono::minutes{ *minutes };
+                return true;
+            }
+            return false;
+        }
+    };
+
+    // The reference zones, then the military ones and extendedTimeZoneTable (BST, CET, JST, AEST...).
+    using ExtendedZones = TableZones<extendedTimeZoneTable, MilitaryZones>;
+
+    // The dialect of parse() and parseDateAndTimeSpecRegex().
+    struct ReferenceDialect
+    {
+        static constexpr std::size_t minYearDigits = 2;
+        static constexpr std::size_t maxYearDigits = 4;
+
+        // The full year for a year token of the given number of digits
+        static constexpr int expandYear(int year, std::size_t /*digits*/) noexcept
+        {
+            return (year < 100) ? year + 2000 : year; // assume year 2000+
+        }
+
+        static constexpr Whitespace whitespace = Whitespace::runs;
+        static constexpr bool caseInsensitive = false;  // For the names of days, months and zones
+        static constexpr bool secondsOptional = true;
+        static constexpr bool checkWeekday = false;     // As in StrictWeekday
+        using Zones = ReferenceZones;
+    };
+
+    // RFC 822 as written: 2-digit years, names in any case (as in all ABNF), every military zone,
+    // and the day of week must match the date.
+    struct Rfc822Dialect : ReferenceDialect
+    {
+        static constexpr std::size_t maxYearDigits = 2;
+        static constexpr bool caseInsensitive = true;
+        static constexpr bool checkWeekday = true;
+        using Zones = MilitaryZones;
+    };
+
+    // RFC 5322 (and 2822) including the obsolete syntax, where 2-digit years below 50 are 20xx,
+    // the other 2-digit and 3-digit years are 1900 + year.
+    struct Rfc5322Dialect : ReferenceDialect
+    {
+        static constexpr int expandYear(int year, std::size_t digits) noexcept
+        {
+            if(digits == 2)
+                return (year < 50) ? year + 2000 : year + 1900;
+            return (digits == 3) ? year + 1900 : year;
+        }
+
+        static constexpr bool caseInsensitive = true;
+        static constexpr bool checkWeekday = true;
+        using Zones = MilitaryZones;
+    };
+
+    // RSS 2.0, which requires 4-digit years.
+    struct RssDialect : ReferenceDialect
+    {
+        static constexpr std::size_t minYearDigits = 4;
+    };
+
+
+    // The reference dialect, with the zones of ExtendedZones.
+    struct ExtendedDialect : ReferenceDialect
+    {
+        using Zones = ExtendedZones;
+    };
+
+    // For hand-written or mangled inputs: names in any case, whitespace around the stamp and every zone of ExtendedZones.
+    struct LenientDialect : ReferenceDialect
+    {
+        static constexpr Whitespace whitespace = Whitespace::lenient;
+        static constexpr bool caseInsensitive = true;
+        using Zones = ExtendedZones;
+    };
+
+    template <class Dialect>
+    class BasicParser
+    {
+    public:
+        // Parse stamp in this dialect. Rejected stamps are zero-initialized apart from the error and its offset.
+        static constexpr ParseResult parse(std::string_view stamp) noexcept
+        {
+            ParseResult result;
+            std::size_t pos = 0;
+            if constexpr(Dialect::whitespace == Whitespace::lenient)
+            {
+                detail::skipSpaces(stamp, pos);
+                while(stamp.size() > pos && detail::isSpace(stamp.back()))
+                    stamp.remove_suffix(1);
+            }
+
+            int weekday = -1;
+            std::int64_t daysFromEpoch = 0;
+            if(!scanDate(stamp, pos, result, weekday) || !scanTime(stamp, pos, result) || !detail::checkBounds(result, daysFromEpoch))
+                return detail::rejection(result);
+
+            if constexpr(Dialect::checkWeekday)
+            {
+                if(!detail::checkWeekday(result, weekday, daysFromEpoch))
+                    return detail::rejection(result);
+            }
+
+            result.time = generateUTCTime(result.dateTime, daysFromEpoch);
+            result.valid = true;
+            return result;
+        }
+
+    private:
+        // The whitespace between tokens. Only required whitespace can fail.
+        static constexpr bool skipSeparator(std::string_view stamp, std::size_t& pos, bool required) noexcept
+        {
+            if constexpr(Dialect::whitespace == Whitespace::single)
+            {
+                if(pos < stamp.size() && stamp[pos] == ' ')
+                {
+                    ++pos;
+                    return true;
+                }
+                return !required;
+            }
+            else
+            {
+                return required ? detail::skipRequiredSpaces(stamp, pos) : (detail::skipSpaces(stamp, pos), true);
+            }
+        }
+
+        static constexpr char toUpper(char c) noexcept
+        {
+            return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        }
+
+        static constexpr char toLower(char c) noexcept
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        // Look up a month or weekday name of 3 characters, which are spelled "Jan" in the tables
+        template <class Lookup>
+        static constexpr int findName(std::string_view name, Lookup lookup) noexcept
+        {
+            if constexpr(Dialect::caseInsensitive)
+            {
+                const char folded[3] = { toUpper(name[0]), toLower(name[1]), toLower(name[2]) };
+                return lookup(std::string_view{ folded, 3 });
+            }
+            else
+            {
+                return lookup(name);
+            }
+        }
+
+        static constexpr bool findZone(std::string_view name, std::chrono::minutes& differential) noexcept
+        {
+            if constexpr(Dialect::caseInsensitive)
+            {
+                // Longer names can't be packed into the name tables anyway
+                char folded[8] = {};
+                if(name.size() > sizeof(folded))
+                    return false;
+                for(std::size_t i = 0; i < name.size(); ++i)
+                    folded[i] = toUpper(name[i]);
+                return Dialect::Zones::find({ folded, name.size() }, differential);
+            }
+            else
+            {
+                return Dialect::Zones::find(name, differential);
+            }
+        }
+
+        // As detail::scanDate(), in this dialect. weekday is set to the day of week, if there is one.
+        static constexpr bool scanDate(std::string_view stamp, std::size_t& pos, ParseResult& out, int& weekday) noexcept
+        {
+            // [ day "," ]
+            if(stamp.size() - pos >= 4 && stamp[pos + 3] == ',' &&
+                (weekday = findName(stamp.substr(pos, 3), [](std::string_view name) { return weekdayFromName(name); })) >= 0)
+            {
+                out.tokens.dayOfWeek = { static_cast<std::uint32_t>(pos), 3 };
+                pos += 4;
+            }
+            skipSeparator(stamp, pos, false);
+
+            // date = 1*2DIGIT month year
+            if(!detail::scanDigits(stamp, pos, 1, 2, out.tokens.day, out.dateTime.day))
+            {
+                // Letters here are a day of week that isn't one, or that has no ","
+                const bool badWeekday = weekday < 0 && pos < stamp.size() && detail::isAsciiLetter(stamp[pos]);
+                return detail::fail(out, badWeekday ? ParseError::badWeekday : ParseError::badDay, pos);
+            }
+            if(!skipSeparator(stamp, pos, true))
+                return detail::fail(out, ParseError::badDay, pos);
+
+            if(stamp.size() - pos < 3)
+                return detail::fail(out, ParseError::badMonth, pos);
+            if((out.dateTime.month = findName(stamp.substr(pos, 3), [](std::string_view name) { return monthFromName(name); })) == 0)
+                return detail::fail(out, ParseError::badMonth, pos);
+            out.tokens.month = { static_cast<std::uint32_t>(pos), 3 };
+            pos += 3;
+            if(!skipSeparator(stamp, pos, true))
+                return detail::fail(out, ParseError::badMonth, pos);
+
+            if(!detail::scanDigits(stamp, pos, Dialect::minYearDigits, Dialect::maxYearDigits, out.tokens.year, out.dateTime.year) ||
+                !skipSeparator(stamp, pos, true))
+            {
+                return detail::fail(out, ParseError::badYear, pos);
+            }
+            out.dateTime.year = Dialect::expandYear(out.dateTime.year, out.tokens.year.length);
+
+            return true;
+        }
+
+        // As detail::scanTime(), in this dialect.
+        static constexpr bool scanTime(std::string_view stamp, std::size_t pos, ParseResult& out) noexcept
+        {
+            // hour = 2DIGIT ":" 2DIGIT [":" 2DIGIT]
+            if(!detail::scanDigits(stamp, pos, 2, 2, out.tokens.hour, out.dateTime.hour))
+                return detail::fail(out, ParseError::badTime, pos);
+            if(pos == stamp.size() || stamp[pos] != ':')
+                return detail::fail(out, ParseError::badTime, pos);
+            ++pos;
+            if(!detail::scanDigits(stamp, pos, 2, 2, out.tokens.minute, out.dateTime.minute))
+                return detail::fail(out, ParseError::badTime, pos);
+            if(pos < stamp.size() && stamp[pos] == ':')
+            {
+                ++pos;
+                if(!detail::scanDigits(stamp, pos, 2, 2, out.tokens.second, out.dateTime.second))
+                    return detail::fail(out, ParseError::badTime, pos);
+            }
+            else if constexpr(!Dialect::secondsOptional)
+            {
+                return detail::fail(out, ParseError::badTime, pos);
+            }
+            if(!skipSeparator(stamp, pos, true))
+                return detail::fail(out, ParseError::badTime, pos);
+
+            // zone, to the end of the stamp
+            const std::string_view zone = stamp.substr(pos);
+            if(!detail::scanNumericZone(zone, out.dateTime.timeZoneDifferential) && !findZone(zone, out.dateTime.timeZoneDifferential))
+                return detail::fail(out, ParseError::badZone, pos);
+            out.tokens.timeZone = { static_cast<std::uint32_t>(pos), static_cast<std::uint32_t>(zone.size()) };
+            return true;
+        }
+    };
+
+    using ReferenceParser = BasicParser<ReferenceDialect>;
+    using Rfc822Parser = BasicParser<Rfc822Dialect>;
+    using Rfc5322Parser = BasicParser<Rfc5322Dialect>;
+    using RssParser = BasicParser<RssDialect>;
+    using LenientParser = BasicParser<LenientDialect>;
+    using ExtendedParser = BasicParser<ExtendedDialect>;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "rfc882pipeline.h"
+
+namespace rfc882
+{
+    ParsePipeline::ParsePipeline(std::size_t batchSize, char delimiter) :
+        batchSize_{ batchSize ? batchSize : 1 },
+        delimiter_{ delimiter }
+    {
+        stamps_.reserve(batchSize_);
+        time_.resize(batchSize_);
+        timeZoneDifferential_.resize(batchSize_);
+        valid_.resize((batchSize_ + 7) / 8);
+    }
+
+    void ParsePipeline::push(std::string_view chunk)
+    {
+        rest_ = chunk;
+        if(!unfinished_)
+            return;
+
+        // Complete the stamp that the last chunk left unfinished, which then starts the first batch of this one
+        const std::size_t end = chunk.find(delimiter_);
+        if(end == std::string_view::npos)
+        {
+            carry_.append(chunk);
+            rest_ = {};
+            return;
+        }
+        carry_.append(chunk.substr(0, end));
+        rest_.remove_prefix(end + 1);
+        unfinished_ = false;
+        straddler_ = true;
+    }
+
+    bool ParsePipeline::next(ParsedBatch& batch)
+    {
+        stamps_.clear();
+        if(straddler_)
+        {
+            stamps_.push_back(carry_);
+            straddler_ = false;
+        }
+        while(stamps_.size() < batchSize_)
+        {
+            const std::size_t end = rest_.find(delimiter_);
+            if(end == std::string_view::npos)
+                break;
+            stamps_.push_back(rest_.substr(0, end));
+            rest_.remove_prefix(end + 1);
+        }
+
+        if(stamps_.empty())
+        {
+            // The chunk is used up. The last batch may still view carry_; it is done with by now.
+            if(!unfinished_)
+            {
+                carry_.assign(rest_);
+                unfinished_ = !carry_.empty();
+                rest_ = {};
+            }
+            if(!closed_ || !unfinished_)
+            {
+                batch = ParsedBatch{};
+                return false;
+            }
+
+            // The bytes after the last delimiter are the last stamp
+            stamps_.push_back(carry_);
+            unfinished_ = false;
+        }
+
+        batch.stamps = stamps_.data();
+        batch.time = time_.data();
+        batch.timeZoneDifferential = timeZoneDifferential_.data();
+        batch.valid = valid_.data();
+        batch.count = stamps_.size();
+        batch.parsed = parseBatch(stamps_.data(), stamps_.size(), BatchOutput{ time_.data(), timeZoneDifferential_.data(), valid_.data() });
+        return true;
+    }
+
+    void ParsePipeline::reset() noexcept
+    {
+        stamps_.clear();
+        carry_.clear();
+        rest_ = {};
+        unfinished_ = false;
+        straddler_ = false;
+        closed_ = false;
+    }
+}
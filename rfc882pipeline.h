@@ -0,0 +1,241 @@
+#ifndef RFC882PIPELINE_H
+#define RFC882PIPELINE_H
+
+/*
+Incremental batch parsing of a stream of stamps whose chunks arrive from asynchronous I/O, so that the
+parsing is interleaved with the reads instead of following them, and no step of the event loop parses
+more than a bounded batch.
+
+The stream is a sequence of stamps separated by a delimiter ('\n' by default), as for StreamParser
+(rfc882stream.h). A ParsePipeline splits each pushed chunk into batches of at most batchSize stamps and
+parses each one with parseBatch(), when it is asked for it. The stamps are viewed in place; only a stamp
+that straddles two chunks is copied. A batch ends at the end of its chunk, so its size is bounded but
+not fixed.
+
+The caller pulls: a chunk must stay valid until next() returns false, and the next chunk is only pushed
+then. This is the backpressure: the next read isn't started until the stamps of the last one are
+parsed, and since each next() parses one batch, the event loop can run other work between them.
+
+    rfc882::ParsePipeline pipeline;
+    rfc882::ParsedBatch batch;
+    while(std::size_t size = read(buffer))
+    {
+        pipeline.push({ buffer, size });
+        while(pipeline.next(batch))     // or one batch per turn of the event loop
+            store(batch);
+    }
+    pipeline.close();                   // the bytes after the last delimiter, if any, are the last stamp
+    while(pipeline.next(batch))
+        store(batch);
+
+feed() and finish() do the same with a callback, which is called for every batch. In C++20,
+parseAsync() wraps a ParsePipeline in a coroutine that co_awaits the chunks from an asynchronous
+source and yields the batches to a consuming coroutine (see below).
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rfc882datetime.h"
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <utility> // for std::exchange()
+#define RFC882_HAS_COROUTINES 1
+#endif
+
+namespace rfc882
+{
+    // Enough stamps for parseBatch() to keep its kernels busy, few enough to parse in a few microseconds
+    constexpr std::size_t pipelineBatchSize = 256;
+
+    // A batch of stamps and their results, as parseBatch() writes them. Everything it points to stays valid
+    // until the next call to next(), push() or close() of its pipeline.
+    struct ParsedBatch
+    {
+        const std::string_view* stamps = nullptr;
+        const std::chrono::system_clock::time_point* time = nullptr;   // In UTC; the epoch for the stamps that didn't parse
+        const std::int16_t* timeZoneDifferential = nullptr;            // In minutes; 0 for the stamps that didn't parse
+        const std::uint8_t* valid = nullptr;                           // Bitmap, as in BatchOutput
+        std::size_t count = 0;
+        std::size_t parsed = 0;                                        // Number of stamps that parsed
+
+        bool isValid(std::size_t i) const noexcept { return (valid[i / 8] >> (i % 8)) & 1; }
+    };
+
+    class ParsePipeline
+    {
+    public:
+        explicit ParsePipeline(std::size_t batchSize = pipelineBatchSize, char delimiter = '\n');
+
+        // Hand over the next chunk of the stream. It must stay valid until next() returns false.
+        void push(std::string_view chunk);
+
+        // End the stream, once the last chunk is used up.
+        void close() noexcept { closed_ = true; }
+
+        // Parse the next batch of the pushed chunk into batch. Returns false once the chunk is used up;
+        // the unfinished stamp at its end, if any, is then copied, so the chunk can be reused.
+        bool next(ParsedBatch& batch);
+
+        // push() the chunk and call onBatch(const ParsedBatch&) for each of its batches.
+        template <class Callback>
+        void feed(std::string_view chunk, Callback&& onBatch)
+        {
+            push(chunk);
+            ParsedBatch batch;
+            while(next(batch))
+                onBatch(batch);
+        }
+
+        // close() the stream and call onBatch(const ParsedBatch&) for the last stamp, if any.
+        template <class Callback>
+        void finish(Callback&& onBatch)
+        {
+            close();
+            ParsedBatch batch;
+            while(next(batch))
+                onBatch(batch);
+        }
+
+        // Drop the unfinished stamp and the rest of the pushed chunk, and reopen the stream.
+        void reset() noexcept;
+
+        std::size_t batchSize() const noexcept { return batchSize_; }
+
+        char delimiter() const noexcept { return delimiter_; }
+
+    private:
+        std::vector<std::string_view> stamps_;          // The stamps of the last batch
+        std::vector<std::chrono::system_clock::time_point> time_;
+        std::vector<std::int16_t> timeZoneDifferential_;
+        std::vector<std::uint8_t> valid_;
+        std::string carry_;                             // The stamp that straddles chunks
+        std::string_view rest_;                         // What isn't split into batches yet of the pushed chunk
+        bool unfinished_ = false;                       // carry_ is the start of a stamp, waiting for its delimiter
+        bool straddler_ = false;                        // carry_ is a whole stamp, to start the next batch with
+        bool closed_ = false;
+        std::size_t batchSize_;
+        char delimiter_;
+    };
+
+#ifdef RFC882_HAS_COROUTINES
+    // The batches of parseAsync(), for a coroutine to co_await one at a time:
+    //
+    //     rfc882::AsyncBatches batches = rfc882::parseAsync([&socket] { return socket.asyncRead(buffer); });
+    //     while(const rfc882::ParsedBatch* batch = co_await batches.next())
+    //         store(*batch);
+    //
+    // Each co_await resumes the parsing coroutine, which parses the next batch, or co_awaits the next chunk
+    // first; the consumer is resumed when the batch is ready, or with nullptr at the end of the stream.
+    // Only one coroutine may await the batches, and *batch is valid until it awaits the next one.
+    class AsyncBatches
+    {
+    public:
+        struct promise_type;
+
+        AsyncBatches(AsyncBatches&& other) noexcept : coroutine_{ std::exchange(other.coroutine_, {}) } {}
+        AsyncBatches& operator=(AsyncBatches&& other) noexcept
+        {
+            std::swap(coroutine_, other.coroutine_);
+            return *this;
+        }
+        ~AsyncBatches()
+        {
+            if(coroutine_)
+                coroutine_.destroy();
+        }
+
+        // Awaitable for the next batch. Rethrows what the source threw.
+        auto next() noexcept
+        {
+            struct Next
+            {
+                std::coroutine_handle<promise_type> coroutine;
+
+                bool await_ready() const noexcept { return coroutine.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept
+                {
+                    coroutine.promise().consumer = consumer;
+                    return coroutine;
+                }
+
+                const ParsedBatch* await_resume() const
+                {
+                    if(coroutine.promise().exception)
+                        std::rethrow_exception(coroutine.promise().exception);
+                    return coroutine.promise().batch;
+                }
+            };
+            return Next{ coroutine_ };
+        }
+
+        struct promise_type
+        {
+            // Suspend the parsing coroutine and resume the consumer
+            struct Yield
+            {
+                bool await_ready() const noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> coroutine) const noexcept { return coroutine.promise().consumer; }
+                void await_resume() const noexcept {}
+            };
+
+            const ParsedBatch* batch = nullptr;         // nullptr at the end
+            std::coroutine_handle<> consumer;
+            std::exception_ptr exception;
+
+            AsyncBatches get_return_object() noexcept { return AsyncBatches{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            Yield final_suspend() noexcept
+            {
+                batch = nullptr;
+                return {};
+            }
+            Yield yield_value(const ParsedBatch& value) noexcept
+            {
+                batch = &value;
+                return {};
+            }
+            void return_void() const noexcept {}
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+    private:
+        explicit AsyncBatches(std::coroutine_handle<promise_type> coroutine) noexcept : coroutine_{ coroutine } {}
+
+        std::coroutine_handle<promise_type> coroutine_;
+    };
+
+    // Parse the chunks of source in batches. source() must return an awaitable whose result converts to
+    // std::string_view: the next chunk, which must stay valid until source() is called again, or an empty
+    // chunk at the end of the stream. source() is only called once the last chunk is parsed.
+    template <class Source>
+    AsyncBatches parseAsync(Source source, std::size_t batchSize = pipelineBatchSize, char delimiter = '\n')
+    {
+        ParsePipeline pipeline{ batchSize, delimiter };
+        ParsedBatch batch;
+        for(;;)
+        {
+            const std::string_view chunk = co_await source();
+            if(chunk.empty())
+                break;
+
+            pipeline.push(chunk);
+            while(pipeline.next(batch))
+                co_yield batch;
+        }
+
+        pipeline.close();
+        while(pipeline.next(batch))
+            co_yield batch;
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include "rfc882pmr.h"
+
+namespace rfc882
+{
+    std::optional<pmr::RFC882DateTime> parseDateAndTimeSpec(std::string_view stamp, std::pmr::memory_resource* resource)
+    {
+        return toDateTime(stamp, parse(stamp), resource);
+    }
+
+    std::optional<pmr::RFC882DateTime> toDateTime(std::string_view stamp, const ParseResult& result, std::pmr::memory_resource* resource)
+    {
+        if(!result)
+            return std::nullopt;
+
+        std::optional<pmr::RFC882DateTime> date{ std::in_place, pmr::RFC882DateTime::allocator_type{ resource } };
+        date->stamp = stamp;
+        date->tokens.dayOfWeek = token(stamp, result.tokens.dayOfWeek);
+        date->tokens.day = token(stamp, result.tokens.day);
+        date->tokens.month = token(stamp, result.tokens.month);
+        date->tokens.year = token(stamp, result.tokens.year);
+        date->tokens.hour = token(stamp, result.tokens.hour);
+        date->tokens.minute = token(stamp, result.tokens.minute);
+        date->tokens.second = token(stamp, result.tokens.second);
+        date->tokens.timeZone = token(stamp, result.tokens.timeZone);
+
+        date->time = result.time;
+        date->dateTime = result.dateTime;
+
+        return date;
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef RFC882PMR_H
+#define RFC882PMR_H
+
+/*
+Allocator-aware counterpart of RFC882DateTime, whose strings come from a std::pmr::memory_resource.
+Back a whole batch of stamps with one arena and release it at once:
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<rfc882::pmr::RFC882DateTime> dates{ &arena };
+    for(std::string_view stamp : batch)
+    {
+        if(auto date = rfc882::parseDateAndTimeSpec(stamp, &arena))
+            dates.push_back(std::move(*date));
+    }
+
+The type follows the uses-allocator protocol, so pmr containers construct their elements on their own
+resource. The tokens are short enough for the small string buffer, so usually only the stamp takes
+memory from the resource.
+*/
+
+#include <chrono>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility> // for std::move()
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    namespace pmr
+    {
+        struct RFC882DateTime
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+            std::pmr::string stamp;                         // The RFC882 formatted time stamp, unaltered.
+            std::chrono::system_clock::time_point time{};   // The point in time that this time stamp represents, in UTC.
+
+            // As rfc882::RFC882DateTime::Tokens
+            struct Tokens
+            {
+                using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+                std::pmr::string dayOfWeek;
+                std::pmr::string day;
+                std::pmr::string month;
+                std::pmr::string year;
+
+                std::pmr::string hour;
+                std::pmr::string minute;
+                std::pmr::string second;
+
+                std::pmr::string timeZone;
+
+                Tokens() = default;
+                Tokens(const Tokens&) = default;
+                Tokens(Tokens&&) = default;
+                Tokens& operator=(const Tokens&) = default;
+                Tokens& operator=(Tokens&&) = default;
+
+                explicit Tokens(const allocator_type& allocator) noexcept
+                    : dayOfWeek{ allocator }, day{ allocator }, month{ allocator }, year{ allocator },
+                    hour{ allocator }, minute{ allocator }, second{ allocator }, timeZone{ allocator } {}
+
+                Tokens(const Tokens& other, const allocator_type& allocator)
+                    : dayOfWeek{ other.dayOfWeek, allocator }, day{ other.day, allocator }, month{ other.month, allocator }, year{ other.year, allocator },
+                    hour{ other.hour, allocator }, minute{ other.minute, allocator }, second{ other.second, allocator }, timeZone{ other.timeZone, allocator } {}
+
+                Tokens(Tokens&& other, const allocator_type& allocator)
+                    : dayOfWeek{ std::move(other.dayOfWeek), allocator }, day{ std::move(other.day), allocator },
+                    month{ std::move(other.month), allocator }, year{ std::move(other.year), allocator },
+                    hour{ std::move(other.hour), allocator }, minute{ std::move(other.minute), allocator },
+                    second{ std::move(other.second), allocator }, timeZone{ std::move(other.timeZone), allocator } {}
+            } tokens;
+
+            rfc882::RFC882DateTime::DateTime dateTime;
+
+            RFC882DateTime() = default;
+            RFC882DateTime(const RFC882DateTime&) = default;
+            RFC882DateTime(RFC882DateTime&&) = default;
+            RFC882DateTime& operator=(const RFC882DateTime&) = default;
+            RFC882DateTime& operator=(RFC882DateTime&&) = default;
+
+            explicit RFC882DateTime(const allocator_type& allocator) noexcept : stamp{ allocator }, tokens{ allocator } {}
+
+            RFC882DateTime(const RFC882DateTime& other, const allocator_type& allocator)
+                : stamp{ other.stamp, allocator }, time{ other.time }, tokens{ other.tokens, allocator }, dateTime{ other.dateTime } {}
+
+            RFC882DateTime(RFC882DateTime&& other, const allocator_type& allocator)
+                : stamp{ std::move(other.stamp), allocator }, time{ other.time }, tokens{ std::move(other.tokens), allocator }, dateTime{ other.dateTime } {}
+
+            allocator_type get_allocator() const noexcept { return stamp.get_allocator(); }
+        };
+
+        // Comparison operators, by time as for rfc882::RFC882DateTime.
+        inline bool operator<(const RFC882DateTime& x, const RFC882DateTime& y)
+        {
+            return x.time < y.time;
+        }
+
+        inline bool operator<=(const RFC882DateTime& x, const RFC882DateTime& y)
+        {
+            return x.time <= y.time;
+        }
+
+        inline bool operator>(const RFC882DateTime& x, const RFC882DateTime& y)
+        {
+            return x.time > y.time;
+        }
+
+        inline bool operator>=(const RFC882DateTime& x, const RFC882DateTime& y)
+        {
+            return x.time >= y.time;
+        }
+
+        inline bool operator==(const RFC882DateTime& x, const RFC882DateTime& y)
+        {
+            return x.time == y.time;
+        }
+    }
+
+    // Same as parseDateAndTimeSpec(), with the strings allocated from resource.
+    std::optional<pmr::RFC882DateTime> parseDateAndTimeSpec(std::string_view stamp, std::pmr::memory_resource* resource);
+
+    // Copy the tokens of a parsed stamp into a pmr::RFC882DateTime allocated from resource.
+    // result must come from parsing stamp. Returns std::nullopt if result isn't valid.
+    std::optional<pmr::RFC882DateTime> toDateTime(std::string_view stamp, const ParseResult& result, std::pmr::memory_resource* resource);
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef RFC882PREFILTER_H
+#define RFC882PREFILTER_H
+
+/*
+Fast rejection of inputs that can't be RFC882 stamps, with the reason, so that callers can route them
+to another parser (ISO 8601, localized dates...) without trying this one first.
+
+prefilter() never rejects a stamp that parse() accepts; inputs that pass still need to be parsed.
+The checks are made in this order, and the first one that fails is reported:
+
+    tooShort            fewer than minimumStampSize characters
+    invalidZone         the stamp doesn't end with a letter or a 4-digit differential after a sign
+    missingTime         the first ':' isn't in "<whitespace>DD:DD"
+    invalidCharacter    anything but digits, ASCII letters, whitespace and ",:+-"
+    tooLong             more than maximumVisibleCharacters characters that aren't whitespace
+                        (whitespace runs are unbounded in the grammar)
+    invalidZone         a '+' or '-' that isn't the sign of the zone
+
+The first three only look at a few bytes, so most garbage is rejected without reading all of it.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882scanner.h"
+
+namespace rfc882
+{
+    enum class RejectReason : std::uint8_t
+    {
+        none,               // Could be a stamp
+        tooShort,
+        tooLong,
+        invalidCharacter,
+        missingTime,
+        invalidZone
+    };
+
+    // "1 Jan 00 00:00 Z"
+    constexpr std::size_t minimumStampSize = 16;
+
+    // "Mon," "DD" "Mon" "YYYY" "HH:MM:SS" "+HHMM"
+    constexpr std::size_t maximumVisibleCharacters = 26;
+
+    namespace detail
+    {
+        // Character classes, as bits of stampCharacterClasses
+        constexpr std::uint8_t visibleCharacter = 1;
+        constexpr std::uint8_t signCharacter = 2;
+        constexpr std::uint8_t invalidCharacter = 4;
+
+        constexpr std::array<std::uint8_t, 256> makeStampCharacterClasses() noexcept
+        {
+            std::array<std::uint8_t, 256> classes{};
+            for(auto& c : classes)
+                c = invalidCharacter;
+            for(char c = '0'; c <= '9'; ++c)
+                classes[static_cast<unsigned char>(c)] = visibleCharacter;
+            for(char c = 'A'; c <= 'Z'; ++c)
+            {
+                classes[static_cast<unsigned char>(c)] = visibleCharacter;
+                classes[static_cast<unsigned char>(c - 'A' + 'a')] = visibleCharacter;
+            }
+            for(char c : std::string_view{ " \t\n\v\f\r" })
+                classes[static_cast<unsigned char>(c)] = 0;
+            classes[static_cast<unsigned char>(',')] = visibleCharacter;
+            classes[static_cast<unsigned char>(':')] = visibleCharacter;
+            classes[static_cast<unsigned char>('+')] = visibleCharacter | signCharacter;
+            classes[static_cast<unsigned char>('-')] = visibleCharacter | signCharacter;
+            return classes;
+        }
+
+        inline constexpr std::array<std::uint8_t, 256> stampCharacterClasses = makeStampCharacterClasses();
+
+        constexpr std::uint8_t stampCharacterClass(char c) noexcept
+        {
+            return stampCharacterClasses[static_cast<unsigned char>(c)];
+        }
+    }
+
+    constexpr RejectReason prefilter(std::string_view stamp) noexcept
+    {
+        if(stamp.size() < minimumStampSize)
+            return RejectReason::tooShort;
+
+        // zone = name / ( ("+" / "-") 4DIGIT )
+        const bool numericZone = stamp[stamp.size() - 5] == '+' || stamp[stamp.size() - 5] == '-';
+        if(numericZone ? !detail::isDigit(stamp.back()) : !detail::isAsciiLetter(stamp.back()))
+            return RejectReason::invalidZone;
+
+        // hour = <whitespace> 2DIGIT ":" 2DIGIT
+        const std::size_t colon = stamp.find(':');
+        if(colon == std::string_view::npos || colon < 3 || colon + 2 >= stamp.size() ||
+            !detail::isSpace(stamp[colon - 3]) || !detail::isDigit(stamp[colon - 2]) || !detail::isDigit(stamp[colon - 1]) ||
+            !detail::isDigit(stamp[colon + 1]) || !detail::isDigit(stamp[colon + 2]))
+        {
+            return RejectReason::missingTime;
+        }
+
+        // The character classes are accumulated without branching, and checked every block of bytes so
+        // that long inputs are rejected early.
+        constexpr std::size_t blockSize = 16;
+        std::size_t visible = 0;
+        std::size_t signs = 0;
+        for(std::size_t block = 0; block < stamp.size(); block += blockSize)
+        {
+            const std::size_t end = (stamp.size() - block < blockSize) ? stamp.size() : block + blockSize;
+            std::uint8_t classes = 0;
+            for(std::size_t i = block; i < end; ++i)
+            {
+                const std::uint8_t c = detail::stampCharacterClass(stamp[i]);
+                classes |= c;
+                visible += c & detail::visibleCharacter;
+                signs += (c & detail::signCharacter) >> 1;
+            }
+            if(classes & detail::invalidCharacter)
+                return RejectReason::invalidCharacter;
+            if(visible > maximumVisibleCharacters)
+                return RejectReason::tooLong;
+        }
+
+        if(signs != (numericZone ? 1 : 0))
+            return RejectReason::invalidZone;
+
+        return RejectReason::none;
+    }
+
+    constexpr std::string_view rejectReasonName(RejectReason reason) noexcept
+    {
+        switch(reason)
+        {
+        case RejectReason::none: return "none";
+        case RejectReason::tooShort: return "tooShort";
+        case RejectReason::tooLong: return "tooLong";
+        case RejectReason::invalidCharacter: return "invalidCharacter";
+        case RejectReason::missingTime: return "missingTime";
+        case RejectReason::invalidZone: return "invalidZone";
+        }
+        return "unknown";
+    }
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include <algorithm> // for std::find()
+#include <array>
+#include <cstdint>
+#include <cstdlib> // for std::div()
+#include <ctime> // for std::time_t
+#include <iterator> // for std::distance()
+#include <utility> // for std::move()
+
+#include "rfc882regex.h"
+
+// The reference is the baseline for the differential tests, so it has a calendar and name lookups of its own,
+// written for obviousness instead of speed: it shares no code with the engines that it is compared with.
+
+namespace rfc882
+{
+    // Function prototypes
+    std::chrono::minutes parseLocalDifferential(const std::string& localDifferential);
+    int parseMonth(const std::string& month) noexcept;
+    std::chrono::minutes parseTimeZone(const std::string& timezone);
+
+    namespace
+    {
+        bool isLeapYear(int year) noexcept
+        {
+            // Divisible by 4, and either not by 100 or by 400
+            return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        }
+
+        int lastDayOfMonth(int year, int month) noexcept
+        {
+            switch(month)
+            {
+            case 2:
+                return isLeapYear(year) ? 29 : 28;
+            case 4: case 6: case 9: case 11:
+                return 30;
+            default:
+                return 31;
+            }
+        }
+
+        bool isValidDate(const RFC882DateTime::DateTime& date) noexcept
+        {
+            return date.month >= 1 && date.month <= 12 && date.day >= 1 && date.day <= lastDayOfMonth(date.year, date.month);
+        }
+
+        bool isValidTime(const RFC882DateTime::DateTime& date) noexcept
+        {
+            return
+                (date.hour >= 0 && date.hour <= 23) &&
+                (date.minute >= 0 && date.minute <= 59) &&
+                (date.second >= 0 && date.second <= 59);
+        }
+
+        // Days from 0000-01-01 to the first day of year, which is in [0, 9999]. Year 0 is a leap year, so the
+        // leap years before year are the multiples of 4, 100 and 400 below it, counted from 0.
+        std::int64_t daysBeforeYear(std::int64_t year) noexcept
+        {
+            return 365 * year + (year + 3) / 4 - (year + 99) / 100 + (year + 399) / 400;
+        }
+
+        std::int64_t daysFromEpoch(const RFC882DateTime::DateTime& date) noexcept
+        {
+            constexpr std::array<int, 12> daysBeforeMonth{ 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+            const int leapDay = (date.month > 2 && isLeapYear(date.year)) ? 1 : 0;
+            return daysBeforeYear(date.year) - daysBeforeYear(1970) + daysBeforeMonth[date.month - 1] + leapDay + date.day - 1;
+        }
+
+        std::chrono::system_clock::time_point generateUTCTime(const RFC882DateTime::DateTime& date) noexcept
+        {
+            const std::time_t localizedTime = (((
+                (24 * static_cast<std::time_t>(daysFromEpoch(date)) + date.hour) * 60) // convert days/hour to minutes
+                + date.minute) * 60) // convert minutes to seconds
+                + date.second; // add remaining seconds
+
+            // Then convert that to a std::chrono time_point and then convert to UTC
+            return std::chrono::system_clock::from_time_t(localizedTime) - date.timeZoneDifferential;
+        }
+    }
+
+    namespace detail
+    {
+        const std::regex& rfc882Regex()
+        {
+            // Compiled on first use; initialization of function-local statics is thread-safe
+            static const std::regex pattern{ rfc882RegexPattern };
+            return pattern;
+        }
+    }
+
+    RegexParser::RegexParser() : RegexParser{ detail::rfc882Regex() }
+    {
+    }
+
+    RegexParser::RegexParser(const std::regex& pattern) : pattern_{ &pattern }
+    {
+    }
+
+    std::optional<RFC882DateTime> RegexParser::parse(std::string stamp)
+    {
+        if(std::regex_match(stamp, results_, *pattern_))
+        {
+            // This timestamp is verified to be RFC882 compliant. Now, parse the data into an RFC882DateTime structure.
+            RFC882DateTime date;
+            
+            // Gather the tokens and convert them to integers, as necessary.
+            // The regex matching guarantees that std::stoi will not fail.
+            date.tokens.dayOfWeek = results_[1].matched ? std::string{ results_[1].first, results_[1].second - 1 } : "";
+
+            date.dateTime.day = std::stoi(date.tokens.day = results_[2].str());
+            date.dateTime.month = parseMonth(date.tokens.month = results_[3].str());
+            date.dateTime.year = std::stoi(date.tokens.year = results_[4].str());
+            if(date.dateTime.year < 100)
+                date.dateTime.year += 2000; // assume year 2000+
+
+            date.dateTime.hour = std::stoi(date.tokens.hour = results_[5].str());
+            date.dateTime.minute = std::stoi(date.tokens.minute = results_[6].str());
+            date.tokens.second = results_[7].matched ? std::string{ results_[7].first + 1, results_[7].second } : "";
+            date.dateTime.second = (date.tokens.second.size()) ? std::stoi(date.tokens.second) : 0;
+
+            date.dateTime.timeZoneDifferential = parseTimeZone(date.tokens.timeZone = results_[8].str());
+
+            // Make sure that the date and time are not out of normal bounds.
+            if(!isValidDate(date.dateTime) || !isValidTime(date.dateTime))
+                return std::nullopt;
+
+            // Calculate the time point
+            date.time = generateUTCTime(date.dateTime);
+
+            // It is now safe to invalidate the std::smatch pointers (results_ is not used until the next match)
+            date.stamp = std::move(stamp);
+
+            return date;
+        }
+        
+        // The timestamp is not RFC882 compliant
+        return std::nullopt;
+    }
+
+    std::chrono::minutes parseLocalDifferential(const std::string& localDifferential)
+    {
+        // Precondition: this is a valid local differential of the form (+/-)HHMM
+        std::div_t res = std::div(std::stoi(localDifferential), 100);
+
+        return { std::chrono::hours{res.quot} + std::chrono::minutes{res.rem} };
+    }
+
+    int parseMonth(const std::string& month) noexcept
+    {
+        const std::array<char[4], 12> months{ "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        auto pos = std::find(months.begin(), months.end(), month);
+        return (pos == months.end()) ? 0 : static_cast<int>(std::distance(months.begin(), pos)) + 1;
+    }
+    
+    std::chrono::minutes parseTimeZone(const std::string& timezone)
+    {
+        using namespace std::chrono_literals;
+
+        if(!timezone.empty() && (timezone.front() == '+' || timezone.front() == '-'))
+            return parseLocalDifferential(timezone);
+
+        if(timezone == "EST")
+            return -5h;
+        if(timezone == "EDT")
+            return -4h;
+
+        if(timezone == "CST")
+            return -6h;
+        if(timezone == "CDT")
+            return -5h;
+
+        if(timezone == "MST")
+            return -7h;
+        if(timezone == "MDT")
+            return -6h;
+
+        if(timezone == "PST")
+            return -8h;
+        if(timezone == "PDT")
+            return -7h;
+
+        if(timezone == "A")
+            return -1h;
+        if(timezone == "M")
+            return -12h;
+        if(timezone == "N")
+            return 1h;
+        if(timezone == "Y")
+            return 12h;
+
+        // UT/GMT/Z
+        return 0h;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef RFC882REGEX_H
+#define RFC882REGEX_H
+
+/*
+The std::regex reference implementation of parseDateAndTimeSpec(). It checks and converts the dates with
+a naive calendar of its own, and looks the names up with linear searches, so that the engines compared
+with it don't share their calendar or tables with it.
+
+The pattern is compiled once, on first use, and shared by every RegexParser (using a const std::regex
+from several threads is safe). Each RegexParser also keeps its std::smatch between calls, so matching
+doesn't reallocate the submatch storage. Use one RegexParser per thread.
+*/
+
+#include <optional>
+#include <regex>
+#include <string>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    namespace detail
+    {
+        /*
+         Group1 = Optional day of week (with trailing comma)
+         Group2 = Day of month (3 letters)
+         Group3 = Month (3 letters)
+         Group4 = Year (2 or 4 digits)
+         Group5 = Hour (2 digits)
+         Group6 = Minute (2 digits)
+         Group7 = Optional seconds (2 digits with prepended :)
+         Group8 = Time zone (one of Group9 or Group10 are required)
+         Group9 = Optional named time zone
+         Group10 = Optional local differential
+        */
+        inline constexpr const char* rfc882RegexPattern =
+            R"((Mon,|Tue,|Wed,|Thu,|Fri,|Sat,|Sun,)?\s*(\d{1,2})\s+(Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec)\s+(\d{2,4})\s+(\d{2}):(\d{2})(:\d{2})?\s+((UT|GMT|EST|EDT|CST|CDT|MST|MDT|PST|PDT|Z|A|M|N|Y)|((\+|-)(\d{4}))))";
+
+        // rfc882RegexPattern, compiled once
+        const std::regex& rfc882Regex();
+    }
+
+    class RegexParser
+    {
+    public:
+        // Uses the shared compiled pattern
+        RegexParser();
+
+        // Uses pattern, which must outlive the parser and match the groups of rfc882RegexPattern
+        explicit RegexParser(const std::regex& pattern);
+
+        // Same as parseDateAndTimeSpec()
+        std::optional<RFC882DateTime> parse(std::string stamp);
+
+    private:
+        const std::regex* pattern_;
+        std::smatch results_;
+    };
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef RFC882SCANNER_H
+#define RFC882SCANNER_H
+
+/*
+Single-pass scanner for the RFC882 date-time grammar documented in rfc882datetime.h.
+It accepts exactly the same inputs as the reference std::regex in parseDateAndTimeSpecRegex():
+
+    (Mon,|Tue,|...|Sun,)?\s*(\d{1,2})\s+(Jan|...|Dec)\s+(\d{2,4})\s+(\d{2}):(\d{2})(:\d{2})?\s+(zone)
+
+The numeric fields are converted while scanning, so no second pass over the tokens is needed.
+On failure, the scan functions set out.error and out.errorOffset as documented for ParseError.
+Calendar validation is not done here; see isValidDate() and isValidTime().
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882datetime.h"
+#include "rfc882tables.h"
+
+namespace rfc882::detail
+{
+    // Matches the regex \s class in the "C" locale.
+    constexpr bool isSpace(char c) noexcept
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    constexpr bool isDigit(char c) noexcept
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    constexpr bool isAsciiLetter(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+    // Record why scanning stopped at pos. Returns false, for the scan functions to return.
+    constexpr bool fail(ParseResult& out, ParseError error, std::size_t pos) noexcept
+    {
+        out.error = error;
+        out.errorOffset = static_cast<std::uint32_t>(pos);
+        return false;
+    }
+
+    // What parse() returns for a stamp that failed to scan or validate into scanned:
+    // zero-initialized apart from the error.
+    constexpr ParseResult rejection(const ParseResult& scanned) noexcept
+    {
+        ParseResult result;
+        result.error = scanned.error;
+        result.errorOffset = scanned.errorOffset;
+        return result;
+    }
+
+    constexpr void skipSpaces(std::string_view stamp, std::size_t& pos) noexcept
+    {
+        while(pos < stamp.size() && isSpace(stamp[pos]))
+            ++pos;
+    }
+
+    // \s+
+    constexpr bool skipRequiredSpaces(std::string_view stamp, std::size_t& pos) noexcept
+    {
+        const std::size_t start = pos;
+        skipSpaces(stamp, pos);
+        return pos != start;
+    }
+
+    // \d{minDigits,maxDigits}, also converting the digits to an integer.
+    constexpr bool scanDigits(std::string_view stamp, std::size_t& pos, std::size_t minDigits, std::size_t maxDigits,
+        TokenSpan& token, int& value) noexcept
+    {
+        const std::size_t start = pos;
+        int result = 0;
+        while(pos < stamp.size() && pos - start < maxDigits && isDigit(stamp[pos]))
+            result = result * 10 + (stamp[pos++] - '0');
+
+        if(pos - start < minDigits)
+            return false;
+
+        token = { static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(pos - start) };
+        value = result;
+        return true;
+    }
+
+    // A whole zone of the form ("+" / "-") 4DIGIT
+    constexpr bool scanNumericZone(std::string_view zone, std::chrono::minutes& differential) noexcept
+    {
+        if(zone.size() != 5 || (zone[0] != '+' && zone[0] != '-'))
+            return false;
+        for(std::size_t i = 1; i < 5; ++i)
+        {
+            if(!isDigit(zone[i]))
+                return false;
+        }
+
+        // HHMM, where the minutes are not range checked (same as the reference implementation)
+        const int hours = (zone[1] - '0') * 10 + (zone[2] - '0');
+        const int minutes = (zone[3] - '0') * 10 + (zone[4] - '0');
+        const int sign = (zone[0] == '-') ? -1 : 1;
+        differential = std::chrono::minutes{ sign * (hours * 60 + minutes) };
+        return true;
+    }
+
+    // zone = named zone / ( ("+" / "-") 4DIGIT ), which must run to the end of the stamp.
+    constexpr bool scanTimeZone(std::string_view stamp, std::size_t pos, TokenSpan& token, std::chrono::minutes& differential) noexcept
+    {
+        const std::string_view zone = stamp.substr(pos);
+        if(!scanNumericZone(zone, differential) && !timeZoneFromName(zone, differential))
+            return false;
+
+        token = { static_cast<std::uint32_t>(pos), static_cast<std::uint32_t>(zone.size()) };
+        return true;
+    }
+
+    // date-time is scanned in two stages, so that callers that already know the date part of a stamp
+    // (see rfc882cache.h) can skip straight to the time.
+
+    // [ day "," ] date, including the whitespace after the year. On success, pos is at the hour.
+    constexpr bool scanDate(std::string_view stamp, std::size_t& pos, ParseResult& out) noexcept
+    {
+        // [ day "," ]
+        const bool weekday = stamp.size() - pos >= 4 && stamp[pos + 3] == ',' && weekdayFromName(stamp.substr(pos, 3)) >= 0;
+        if(weekday)
+        {
+            out.tokens.dayOfWeek = { static_cast<std::uint32_t>(pos), 3 };
+            pos += 4;
+        }
+        skipSpaces(stamp, pos);
+
+        // date = 1*2DIGIT month 2DIGIT (2-4 digits here)
+        if(!scanDigits(stamp, pos, 1, 2, out.tokens.day, out.dateTime.day))
+        {
+            // Letters here are a day of week that isn't one, or that has no ","
+            const bool badWeekday = !weekday && pos < stamp.size() && isAsciiLetter(stamp[pos]);
+            return fail(out, badWeekday ? ParseError::badWeekday : ParseError::badDay, pos);
+        }
+        if(!skipRequiredSpaces(stamp, pos))
+            return fail(out, ParseError::badDay, pos);
+
+        if(stamp.size() - pos < 3)
+            return fail(out, ParseError::badMonth, pos);
+        if((out.dateTime.month = monthFromName(stamp.substr(pos, 3))) == 0)
+            return fail(out, ParseError::badMonth, pos);
+        out.tokens.month = { static_cast<std::uint32_t>(pos), 3 };
+        pos += 3;
+        if(!skipRequiredSpaces(stamp, pos))
+            return fail(out, ParseError::badMonth, pos);
+
+        if(!scanDigits(stamp, pos, 2, 4, out.tokens.year, out.dateTime.year) || !skipRequiredSpaces(stamp, pos))
+            return fail(out, ParseError::badYear, pos);
+        if(out.dateTime.year < 100)
+            out.dateTime.year += 2000; // assume year 2000+
+
+        return true;
+    }
+
+    // time, starting at the hour and running to the end of the stamp.
+    constexpr bool scanTime(std::string_view stamp, std::size_t pos, ParseResult& out) noexcept
+    {
+        // hour = 2DIGIT ":" 2DIGIT [":" 2DIGIT]
+        if(!scanDigits(stamp, pos, 2, 2, out.tokens.hour, out.dateTime.hour))
+            return fail(out, ParseError::badTime, pos);
+        if(pos == stamp.size() || stamp[pos] != ':')
+            return fail(out, ParseError::badTime, pos);
+        ++pos;
+        if(!scanDigits(stamp, pos, 2, 2, out.tokens.minute, out.dateTime.minute))
+            return fail(out, ParseError::badTime, pos);
+        if(pos < stamp.size() && stamp[pos] == ':')
+        {
+            ++pos;
+            if(!scanDigits(stamp, pos, 2, 2, out.tokens.second, out.dateTime.second))
+                return fail(out, ParseError::badTime, pos);
+        }
+        if(!skipRequiredSpaces(stamp, pos))
+            return fail(out, ParseError::badTime, pos);
+
+        return scanTimeZone(stamp, pos, out.tokens.timeZone, out.dateTime.timeZoneDifferential) || fail(out, ParseError::badZone, pos);
+    }
+
+    // Scan a whole stamp into out.tokens and out.dateTime. On failure, their contents are unspecified.
+    // out.time and out.valid are left for the caller.
+    constexpr bool scanDateAndTimeSpec(std::string_view stamp, ParseResult& out) noexcept
+    {
+        std::size_t pos = 0;
+        return scanDate(stamp, pos, out) && scanTime(stamp, pos, out);
+    }
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include <cstring> // for std::memcmp() and std::memcpy()
+
+#include "rfc882calendar.h"
+#include "rfc882scanner.h"
+#include "rfc882sequential.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        // The two digits at pos, if they are digits
+        bool scanPair(std::string_view stamp, std::size_t pos, int& value) noexcept
+        {
+            if(!detail::isDigit(stamp[pos]) || !detail::isDigit(stamp[pos + 1]))
+                return false;
+            value = (stamp[pos] - '0') * 10 + (stamp[pos + 1] - '0');
+            return true;
+        }
+
+        // The end of the time of a result: after the seconds if there are any, else after the minutes
+        std::size_t timeEnd(const ParseResult& result) noexcept
+        {
+            const TokenSpan& last = result.tokens.second.length != 0 ? result.tokens.second : result.tokens.minute;
+            return last.offset + last.length;
+        }
+    }
+
+    void SequentialParser::difference(std::string_view stamp, std::size_t& first, std::size_t& end) const noexcept
+    {
+        // 8 bytes at a time from the front, then from the back, and the bytes of the words that differ one by one
+        const std::size_t size = stamp.size() < lastSize_ ? stamp.size() : lastSize_;
+        first = 0;
+        while(first + 8 <= size && std::memcmp(stamp.data() + first, last_ + first, 8) == 0)
+            first += 8;
+        while(first < size && stamp[first] == last_[first])
+            ++first;
+
+        end = stamp.size();
+        if(stamp.size() != lastSize_)
+            return;
+        while(end >= first + 8 && std::memcmp(stamp.data() + end - 8, last_ + end - 8, 8) == 0)
+            end -= 8;
+        while(end > first && stamp[end - 1] == last_[end - 1])
+            --end;
+    }
+
+    bool SequentialParser::reuseTimeDigits(std::string_view stamp, std::size_t first, std::size_t end) noexcept
+    {
+        // Every difference is in HH:MM[:SS], so parse() would scan the same date, separators and zone as for the
+        // last stamp; only the digits can differ, and they must still be digits.
+        const ParseResult::Tokens& tokens = lastResult_.tokens;
+        if(stamp.size() != lastSize_ || first < tokens.hour.offset || end > timeEnd(lastResult_) ||
+            stamp[tokens.minute.offset - 1] != ':' || (tokens.second.length != 0 && stamp[tokens.second.offset - 1] != ':'))
+            return false;
+
+        RFC882DateTime::DateTime dateTime = lastResult_.dateTime;
+        if(!scanPair(stamp, tokens.hour.offset, dateTime.hour) || !scanPair(stamp, tokens.minute.offset, dateTime.minute) ||
+            (tokens.second.length != 0 && !scanPair(stamp, tokens.second.offset, dateTime.second)) || !isValidTime(dateTime))
+            return false;
+
+        // The same day and zone, so the time moves by as much as the fields do
+        const RFC882DateTime::DateTime& last = lastResult_.dateTime;
+        const int delta = ((dateTime.hour - last.hour) * 60 + (dateTime.minute - last.minute)) * 60 + (dateTime.second - last.second);
+        lastResult_.time += std::chrono::seconds{ delta };
+        lastResult_.dateTime = dateTime;
+        std::memcpy(last_ + first, stamp.data() + first, end - first);
+        return true;
+    }
+
+    bool SequentialParser::reuseDate(std::string_view stamp, std::size_t first) noexcept
+    {
+        // The bytes up to the hour are those of the last stamp, so they scan to the same date, ending at the
+        // hour (as in parseCached()). A failure in the time part is left to parse(), which decides the rejection.
+        if(first < lastResult_.tokens.hour.offset)
+            return false;
+
+        ParseResult result;
+        result.tokens.dayOfWeek = lastResult_.tokens.dayOfWeek;
+        result.tokens.day = lastResult_.tokens.day;
+        result.tokens.month = lastResult_.tokens.month;
+        result.tokens.year = lastResult_.tokens.year;
+        result.dateTime.day = lastResult_.dateTime.day;
+        result.dateTime.month = lastResult_.dateTime.month;
+        result.dateTime.year = lastResult_.dateTime.year;
+        if(!detail::scanTime(stamp, lastResult_.tokens.hour.offset, result) || !isValidTime(result.dateTime))
+            return false;
+
+        result.time = generateUTCTime(result.dateTime, lastDaysFromEpoch_);
+        result.valid = true;
+        remember(stamp, first, result);
+        return true;
+    }
+
+    void SequentialParser::remember(std::string_view stamp, std::size_t first, const ParseResult& result) noexcept
+    {
+        std::memcpy(last_ + first, stamp.data() + first, stamp.size() - first);
+        lastSize_ = stamp.size();
+        lastResult_ = result;
+    }
+
+    ParseResult SequentialParser::parse(std::string_view stamp) noexcept
+    {
+        if(stamp.size() > sequentialStampSize)
+        {
+            ++stats_.parsed;
+            return rfc882::parse(stamp);
+        }
+
+        if(lastSize_ != 0)
+        {
+            std::size_t first = 0;
+            std::size_t end = 0;
+            difference(stamp, first, end);
+            if(first == end && stamp.size() == lastSize_)
+            {
+                ++stats_.repeated;
+                return lastResult_;
+            }
+            if(reuseTimeDigits(stamp, first, end))
+            {
+                ++stats_.timeDigits;
+                return lastResult_;
+            }
+            if(reuseDate(stamp, first))
+            {
+                ++stats_.timeScanned;
+                return lastResult_;
+            }
+        }
+
+        ++stats_.parsed;
+        const ParseResult result = rfc882::parse(stamp);
+        if(result)
+        {
+            remember(stamp, 0, result);
+            lastDaysFromEpoch_ = days_from_civil<std::int64_t>(result.dateTime.year,
+                static_cast<unsigned>(result.dateTime.month), static_cast<unsigned>(result.dateTime.day));
+        }
+        return result;
+    }
+
+    void SequentialParser::reset() noexcept
+    {
+        lastSize_ = 0;
+        lastResult_ = ParseResult{};
+        lastDaysFromEpoch_ = 0;
+        stats_ = SequentialStats{};
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef RFC882SEQUENTIAL_H
+#define RFC882SEQUENTIAL_H
+
+/*
+Stateful parser for streams of stamps that are sorted or nearly sorted, such as log files and feeds,
+where consecutive stamps mostly share their date, hour and zone.
+
+SequentialParser remembers the bytes of the last stamp that parsed, with its result and day number,
+and compares each new stamp with them:
+
+    1. The same stamp again returns the same result.
+    2. If only the digits of the time differ (most often the seconds), the new time is the old one plus
+       the difference, so nothing else is scanned or converted.
+    3. If the date is the same up to the hour, only the time is scanned, and the day number is reused.
+    4. Otherwise the stamp is parsed with parse().
+
+The results are always those of parse(). Rejections are always left to parse(), and leave the remembered
+stamp as it was. Stamps that go to parse() cost the comparison on top of it, so stamps in no particular
+order are slower than with parse() alone.
+
+    rfc882::SequentialParser parser;
+    for(std::string_view line : lines)
+        if(const rfc882::ParseResult result = parser.parse(line)) ...
+
+A SequentialParser is about 220 bytes and doesn't allocate. Use one per stream (and per thread).
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    // Stamps longer than this are always parsed in full
+    constexpr std::size_t sequentialStampSize = 64;
+
+    // How many stamps took each path of SequentialParser::parse()
+    struct SequentialStats
+    {
+        std::uint64_t repeated = 0;         // The same stamp as the last one
+        std::uint64_t timeDigits = 0;       // Only the digits of the time differ
+        std::uint64_t timeScanned = 0;      // The same date, with the time scanned
+        std::uint64_t parsed = 0;           // Parsed in full, including every rejection
+    };
+
+    class SequentialParser
+    {
+    public:
+        // Same as rfc882::parse(stamp).
+        ParseResult parse(std::string_view stamp) noexcept;
+
+        // Forget the last stamp and reset the counters.
+        void reset() noexcept;
+
+        const SequentialStats& stats() const noexcept { return stats_; }
+
+    private:
+        // Where stamp differs from the last stamp: every difference is in the bytes [first, end). If the sizes
+        // differ, first is the length of the common prefix and end is the size of stamp.
+        void difference(std::string_view stamp, std::size_t& first, std::size_t& end) const noexcept;
+
+        // Paths 2 and 3, which update the last stamp; false if they don't apply or the stamp doesn't parse through them
+        bool reuseTimeDigits(std::string_view stamp, std::size_t first, std::size_t end) noexcept;
+        bool reuseDate(std::string_view stamp, std::size_t first) noexcept;
+
+        // Make stamp, which parsed into result, the last stamp. Its bytes before first are already there.
+        void remember(std::string_view stamp, std::size_t first, const ParseResult& result) noexcept;
+
+        char last_[sequentialStampSize];
+        std::size_t lastSize_ = 0;          // 0 if there is no last stamp
+        ParseResult lastResult_;
+        std::int64_t lastDaysFromEpoch_ = 0;
+        SequentialStats stats_;
+    };
+}
+
+#endif
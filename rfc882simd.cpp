@@ -0,0 +1,236 @@
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+#include "rfc882calendar.h"
+#include "rfc882simd.h"
+#include "rfc882tables.h"
+
+namespace rfc882::detail
+{
+#if defined(RFC882_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+    bool cpuSupportsAVX2() noexcept
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)
+            return false;
+
+        // The OS must also save the YMM registers on a context switch
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if(!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }
+
+#ifdef RFC882_SIMD_AVX512
+    bool cpuSupportsAVX512() noexcept
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)
+            return false;
+
+        // The OS must also save the opmask and ZMM registers
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if(!osxsave || (_xgetbv(0) & 0xE6) != 0xE6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 16)) != 0;
+    }
+#endif
+
+    bool cpuSupportsSSSE3() noexcept
+    {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+    }
+#elif defined(RFC882_SIMD_X86)
+    bool cpuSupportsAVX2() noexcept
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+
+    bool cpuSupportsSSSE3() noexcept
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3");
+    }
+
+#ifdef RFC882_SIMD_AVX512
+    bool cpuSupportsAVX512() noexcept
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f");
+    }
+#endif
+#endif
+
+    namespace
+    {
+        struct KernelChoice
+        {
+            FixedLayoutKernel kernel;
+            const char* name;
+        };
+
+        KernelChoice selectFixedLayoutKernel() noexcept
+        {
+#if defined(RFC882_SIMD_X86)
+            if(cpuSupportsAVX2())
+                return { fixedLayoutAVX2, "avx2" };
+            if(cpuSupportsSSSE3())
+                return { fixedLayoutSSSE3, "ssse3" };
+#elif defined(RFC882_SIMD_NEON)
+            // NEON is part of the AArch64 baseline
+            return { fixedLayoutNEON, "neon" };
+#endif
+            return { fixedLayoutScalar, "scalar" };
+        }
+
+        const KernelChoice& fixedLayoutKernelChoice() noexcept
+        {
+            static const KernelChoice choice = selectFixedLayoutKernel();
+            return choice;
+        }
+
+        struct DateTimeKernelChoice
+        {
+            DateTimeKernel kernel;
+            const char* name;
+        };
+
+        DateTimeKernelChoice selectDateTimeKernel() noexcept
+        {
+#if defined(RFC882_SIMD_AVX512)
+            if(cpuSupportsAVX512())
+                return { convertDateTimesAVX512, "avx512" };
+#endif
+#if defined(RFC882_SIMD_X86)
+            if(cpuSupportsAVX2())
+                return { convertDateTimesAVX2, "avx2" };
+#endif
+            return { convertDateTimesScalar, "scalar" };
+        }
+
+        const DateTimeKernelChoice& dateTimeKernelChoice() noexcept
+        {
+            static const DateTimeKernelChoice choice = selectDateTimeKernel();
+            return choice;
+        }
+    }
+
+    bool fixedLayoutScalar(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept
+    {
+        for(const auto& separator : fixedLayoutSeparators)
+        {
+            if(stamp[separator.offset] != separator.value)
+                return false;
+        }
+
+        const std::size_t pairCount = numericZone ? 8 : 6;
+        for(std::size_t i = 0; i < pairCount; ++i)
+        {
+            const unsigned tens = static_cast<unsigned char>(stamp[fixedLayoutDigitPairs[i]]) - '0';
+            const unsigned ones = static_cast<unsigned char>(stamp[fixedLayoutDigitPairs[i] + 1]) - '0';
+            if(tens > 9 || ones > 9)
+                return false;
+            pairs[i] = static_cast<std::uint8_t>(tens * 10 + ones);
+        }
+
+        return true;
+    }
+
+    FixedLayoutKernel fixedLayoutKernel() noexcept
+    {
+        return fixedLayoutKernelChoice().kernel;
+    }
+
+    const char* fixedLayoutKernelName() noexcept
+    {
+        return fixedLayoutKernelChoice().name;
+    }
+
+    std::size_t convertDateTimesScalar(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept
+    {
+        std::size_t validCount = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            std::int64_t daysFromEpoch = 0;
+            const bool dateValid = validateDays(dates[i], daysFromEpoch);
+            time[i] = dateValid ? generateUTCTime(dates[i], daysFromEpoch) : std::chrono::system_clock::time_point{};
+            valid[i] = dateValid;
+            validCount += dateValid;
+        }
+        return validCount;
+    }
+
+    DateTimeKernel dateTimeKernel() noexcept
+    {
+        return dateTimeKernelChoice().kernel;
+    }
+
+    const char* dateTimeKernelName() noexcept
+    {
+        return dateTimeKernelChoice().name;
+    }
+
+    bool scanFixedLayout(std::string_view stamp, ParseResult& out) noexcept
+    {
+        const bool numericZone = stamp.size() == fixedLayoutNumericSize;
+        if(!numericZone && stamp.size() != fixedLayoutNamedSize)
+            return false;
+        if(numericZone && stamp[26] != '+' && stamp[26] != '-')
+            return false;
+
+        std::uint8_t pairs[8];
+        if(!fixedLayoutKernel()(stamp.data(), numericZone, pairs))
+            return false;
+
+        if(weekdayFromName(stamp.substr(0, 3)) < 0)
+            return false;
+
+        RFC882DateTime::DateTime dateTime;
+        if((dateTime.month = monthFromName(stamp.substr(8, 3))) == 0)
+            return false;
+
+        if(numericZone)
+        {
+            const int sign = (stamp[26] == '-') ? -1 : 1;
+            dateTime.timeZoneDifferential = std::chrono::minutes{ sign * (pairs[6] * 60 + pairs[7]) };
+        }
+        else if(!timeZoneFromName(stamp.substr(26, 3), dateTime.timeZoneDifferential))
+        {
+            return false;
+        }
+
+        dateTime.day = pairs[0];
+        dateTime.year = pairs[1] * 100 + pairs[2];
+        if(dateTime.year < 100)
+            dateTime.year += 2000; // assume year 2000+
+        dateTime.hour = pairs[3];
+        dateTime.minute = pairs[4];
+        dateTime.second = pairs[5];
+
+        out.dateTime = dateTime;
+        out.tokens.dayOfWeek = { 0, 3 };
+        out.tokens.day = { 5, 2 };
+        out.tokens.month = { 8, 3 };
+        out.tokens.year = { 12, 4 };
+        out.tokens.hour = { 17, 2 };
+        out.tokens.minute = { 20, 2 };
+        out.tokens.second = { 23, 2 };
+        out.tokens.timeZone = { 26, numericZone ? 5u : 3u };
+        return true;
+    }
+}
@@ -0,0 +1,155 @@
+#ifndef RFC882SIMD_H
+#define RFC882SIMD_H
+
+/*
+Vectorized fast path for the two fixed-width stamp layouts that dominate real traffic:
+
+    "Ddd, DD Mon YYYY HH:MM:SS +HHMM"   (31 bytes, numeric zone)
+    "Ddd, DD Mon YYYY HH:MM:SS ZZZ"     (29 bytes, 3-letter named zone such as GMT)
+
+A kernel loads the stamp in place as two overlapping 16-byte halves, the second one ending at the
+last byte (copying it into a padded block first would stall on store forwarding). It then checks
+every separator and digit position with a few compares and converts the eight digit pairs with a
+multiply-add.
+Names (weekday, month, zone) are looked up with the same functions the scanner uses.
+Anything that doesn't fit is left to the scanner, so the fast path never decides a rejection.
+
+The kernel is picked once at run time from what the CPU supports.
+
+The calendar kernels validate and convert arrays of scanned dates to UTC time points for the batch
+engines, 8 (AVX2) or 16 (AVX-512) dates per iteration, with the same branchless arithmetic as
+validateDays() in rfc882calendar.h.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits> // for std::is_signed_v
+
+#include "rfc882datetime.h"
+
+// RFC882_NO_SIMD leaves only the scalar kernels. RFC882_NO_AVX512 leaves out the AVX-512 calendar kernel, for
+// toolchains that can't build it or CPUs that clock down when running it. Either must be defined (or not) for
+// every translation unit of the library.
+#if defined(RFC882_NO_SIMD)
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RFC882_SIMD_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RFC882_SIMD_NEON 1
+#endif
+
+#if defined(RFC882_SIMD_X86) && !defined(RFC882_NO_AVX512)
+#define RFC882_SIMD_AVX512 1
+#endif
+
+// Lets a single function use an instruction set without compiling the whole translation unit for it.
+#if defined(__GNUC__) || defined(__clang__)
+#define RFC882_TARGET(isa) __attribute__((target(isa)))
+#else
+#define RFC882_TARGET(isa)
+#endif
+
+namespace rfc882::detail
+{
+#ifdef RFC882_SIMD_X86
+    // Whether the CPU, and the OS for the wider registers, support the instruction sets of the kernels.
+    // The dispatch picks from these; callers may also run the kernels they allow directly.
+    bool cpuSupportsSSSE3() noexcept;
+    bool cpuSupportsAVX2() noexcept;
+#endif
+#ifdef RFC882_SIMD_AVX512
+    bool cpuSupportsAVX512() noexcept;
+#endif
+
+    constexpr std::size_t fixedLayoutNumericSize = 31;
+    constexpr std::size_t fixedLayoutNamedSize = 29;
+
+    // Offset of the first digit of each pair, in the order the kernels write them:
+    // day, year / 100, year % 100, hour, minute, second, zone hours, zone minutes.
+    // The last two pairs only exist in the numeric zone layout.
+    constexpr std::array<std::size_t, 8> fixedLayoutDigitPairs{ 5, 12, 14, 17, 20, 23, 27, 29 };
+
+    struct FixedLayoutSeparator
+    {
+        std::size_t offset;
+        char value;
+    };
+
+    constexpr std::array<FixedLayoutSeparator, 8> fixedLayoutSeparators{ {
+        { 3, ',' }, { 4, ' ' }, { 7, ' ' }, { 11, ' ' }, { 16, ' ' }, { 19, ':' }, { 22, ':' }, { 25, ' ' }
+    } };
+
+    // Validate the separators and digits of a stamp and write the eight digit pairs.
+    // stamp must have fixedLayoutNumericSize bytes if numericZone is true, fixedLayoutNamedSize bytes otherwise.
+    // The zone pairs are only validated (and meaningful) when numericZone is true.
+    // Returns false if anything is out of place; pairs is unspecified then.
+    using FixedLayoutKernel = bool (*)(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept;
+
+    bool fixedLayoutScalar(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept;
+#ifdef RFC882_SIMD_X86
+    bool fixedLayoutSSSE3(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept;
+    bool fixedLayoutAVX2(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept;
+#endif
+#ifdef RFC882_SIMD_NEON
+    bool fixedLayoutNEON(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept;
+#endif
+
+    // The best kernel for this CPU, and its name ("avx2", "ssse3", "neon" or "scalar").
+    FixedLayoutKernel fixedLayoutKernel() noexcept;
+    const char* fixedLayoutKernelName() noexcept;
+
+    // The calendar kernels load each date as eight 32-bit fields, the differential as its low half.
+    static_assert(sizeof(RFC882DateTime::DateTime) == 32 &&
+        offsetof(RFC882DateTime::DateTime, day) == 0 && offsetof(RFC882DateTime::DateTime, month) == 4 &&
+        offsetof(RFC882DateTime::DateTime, year) == 8 && offsetof(RFC882DateTime::DateTime, hour) == 12 &&
+        offsetof(RFC882DateTime::DateTime, minute) == 16 && offsetof(RFC882DateTime::DateTime, second) == 20 &&
+        offsetof(RFC882DateTime::DateTime, timeZoneDifferential) == 24, "The calendar kernels depend on the layout of DateTime");
+
+    // Check count dates with isValidDate() and isValidTime() and write their UTC time points, as generateUTCTime()
+    // would. valid[i] is set to 1 if dates[i] is valid, and to 0 otherwise, in which case time[i] is the epoch.
+    // Returns the number of valid dates.
+    // The years must be in [0, 9999] and the differentials within a day, as the parsers produce them.
+    using DateTimeKernel = std::size_t (*)(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept;
+
+    // The system_clock ticks of a second, which the vector kernels multiply the seconds since the epoch by:
+    // 1000000000 with libstdc++, 1000000 with libc++ and 10000000 with MSVC.
+    constexpr std::int64_t clockTicksPerSecond = std::chrono::system_clock::period::den / std::chrono::system_clock::period::num;
+
+#ifdef RFC882_SIMD_X86
+    // They store the ticks as 64-bit integers, from 32 x 32 bit products with clockTicksPerSecond
+    static_assert(std::chrono::system_clock::period::num == 1 && clockTicksPerSecond <= 0xFFFFFFFF,
+        "The calendar kernels need a whole number of system_clock ticks per second that fits in 32 bits");
+    static_assert(sizeof(std::chrono::system_clock::time_point) == 8 && std::is_signed_v<std::chrono::system_clock::rep>,
+        "The calendar kernels store system_clock time points as 64-bit signed integers");
+#endif
+
+    std::size_t convertDateTimesScalar(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept;
+#ifdef RFC882_SIMD_X86
+    std::size_t convertDateTimesAVX2(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept;
+#endif
+#ifdef RFC882_SIMD_AVX512
+    std::size_t convertDateTimesAVX512(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept;
+#endif
+
+    // The best calendar kernel for this CPU, and its name ("avx512", "avx2" or "scalar").
+    DateTimeKernel dateTimeKernel() noexcept;
+    const char* dateTimeKernelName() noexcept;
+
+    inline std::size_t convertDateTimes(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept
+    {
+        return dateTimeKernel()(dates, count, time, valid);
+    }
+
+    // Fill out.tokens and out.dateTime if stamp has one of the fixed layouts.
+    // Returns false without touching out otherwise; the caller should then fall back to the scanner.
+    bool scanFixedLayout(std::string_view stamp, ParseResult& out) noexcept;
+}
+
+#endif
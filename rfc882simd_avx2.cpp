@@ -0,0 +1,189 @@
+#include "rfc882calendar.h"
+#include "rfc882simd.h"
+
+#ifdef RFC882_SIMD_X86
+
+#include <bitset>
+
+#include <immintrin.h>
+
+namespace rfc882::detail
+{
+    RFC882_TARGET("avx2")
+    bool fixedLayoutAVX2(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept
+    {
+        // The stamp is shorter than 32 bytes, so load the two 16-byte lanes separately.
+        // The high lane ends at the last byte, so it starts at byte 15 (numeric zone) or 13 (named zone).
+        const __m256i lanes = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(stamp))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(stamp + (numericZone ? 15 : 13))), 1);
+
+        // All separators (see fixedLayoutSeparators) with a single compare
+        const __m256i separators = numericZone ?
+            _mm256_setr_epi8(
+                0, 0, 0, ',', ' ', 0, 0, ' ', 0, 0, 0, ' ', 0, 0, 0, 0,
+                0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, ' ', 0, 0, 0, 0, 0) :
+            _mm256_setr_epi8(
+                0, 0, 0, ',', ' ', 0, 0, ' ', 0, 0, 0, ' ', 0, 0, 0, 0,
+                0, 0, 0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, ' ', 0, 0, 0);
+        constexpr unsigned loSeparatorMask = (1u << 3) | (1u << 4) | (1u << 7) | (1u << 11);
+        const unsigned separatorMask = loSeparatorMask |
+            ((1u << 0) | (1u << 3) | (1u << 6) | (1u << 9)) << (numericZone ? 17 : 19);
+        if((static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lanes, separators))) & separatorMask) != separatorMask)
+            return false;
+
+        // The byte shuffle works within each lane, so gather from both lanes (see fixedLayoutDigitPairs)
+        // into disjoint bytes and merge the two halves; -1 selects zero.
+        const __m256i digitIndices = numericZone ?
+            _mm256_setr_epi8(
+                5, 6, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, 2, 3, 5, 6, 8, 9, 12, 13, 14, 15) :
+            _mm256_setr_epi8(
+                5, 6, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1);
+        const __m256i gathered = _mm256_shuffle_epi8(lanes, digitIndices);
+        const __m128i digits = _mm_sub_epi8(
+            _mm_or_si128(_mm256_castsi256_si128(gathered), _mm256_extracti128_si256(gathered, 1)),
+            _mm_set1_epi8('0'));
+
+        // A byte is a digit if it is unchanged by an unsigned min with 9
+        const int digitMask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits));
+        const int requiredDigits = numericZone ? 0xFFFF : 0x0FFF;
+        if((digitMask & requiredDigits) != requiredDigits)
+            return false;
+
+        // tens * 10 + ones for each pair, then narrow to bytes
+        const __m128i values = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pairs), _mm_packus_epi16(values, values));
+        return true;
+    }
+
+    namespace
+    {
+        // x <= limit, as unsigned
+        RFC882_TARGET("avx2")
+        __m256i atMost(__m256i x, __m256i limit) noexcept
+        {
+            return _mm256_cmpeq_epi32(_mm256_min_epu32(x, limit), x);
+        }
+
+        // x * clockTicksPerSecond in 64-bit lanes, from two 32 x 32 bit products
+        RFC882_TARGET("avx2")
+        __m256i toClockTicks(__m256i x) noexcept
+        {
+            const __m256i ticks = _mm256_set1_epi64x(clockTicksPerSecond);
+            return _mm256_add_epi64(_mm256_mul_epu32(x, ticks),
+                _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), ticks), 32));
+        }
+    }
+
+    RFC882_TARGET("avx2")
+    std::size_t convertDateTimesAVX2(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi32(1);
+
+        std::size_t validCount = 0;
+        std::size_t i = 0;
+        for(; i + 8 <= count; i += 8)
+        {
+            // Transpose eight dates, a row of eight 32-bit fields each, into a vector per field
+            __m256i rows[8];
+            for(int j = 0; j < 8; ++j)
+                rows[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dates + i + j));
+
+            __m256i pairs[8];
+            for(int j = 0; j < 8; j += 2)
+            {
+                pairs[j] = _mm256_unpacklo_epi32(rows[j], rows[j + 1]);
+                pairs[j + 1] = _mm256_unpackhi_epi32(rows[j], rows[j + 1]);
+            }
+
+            __m256i quads[8];
+            for(int j = 0; j < 8; j += 4)
+            {
+                quads[j] = _mm256_unpacklo_epi64(pairs[j], pairs[j + 2]);
+                quads[j + 1] = _mm256_unpackhi_epi64(pairs[j], pairs[j + 2]);
+                quads[j + 2] = _mm256_unpacklo_epi64(pairs[j + 1], pairs[j + 3]);
+                quads[j + 3] = _mm256_unpackhi_epi64(pairs[j + 1], pairs[j + 3]);
+            }
+
+            const __m256i day = _mm256_permute2x128_si256(quads[0], quads[4], 0x20);
+            const __m256i month = _mm256_permute2x128_si256(quads[1], quads[5], 0x20);
+            const __m256i year = _mm256_permute2x128_si256(quads[2], quads[6], 0x20);
+            const __m256i hour = _mm256_permute2x128_si256(quads[3], quads[7], 0x20);
+            const __m256i minute = _mm256_permute2x128_si256(quads[0], quads[4], 0x31);
+            const __m256i second = _mm256_permute2x128_si256(quads[1], quads[5], 0x31);
+            const __m256i differential = _mm256_permute2x128_si256(quads[2], quads[6], 0x31);
+
+            // monthIndex()
+            const __m256i monthValid = atMost(_mm256_sub_epi32(month, one), _mm256_set1_epi32(11));
+            const __m256i index = _mm256_and_si256(month, monthValid);
+
+            // isLeapYear(), with year / 100 as a multiply by its reciprocal
+            const __m256i century = _mm256_srli_epi32(_mm256_mullo_epi32(year, _mm256_set1_epi32(5243)), 19);
+            const __m256i centuryYear = _mm256_cmpeq_epi32(year, _mm256_mullo_epi32(century, _mm256_set1_epi32(100)));
+            const __m256i fourthYear = _mm256_cmpeq_epi32(_mm256_and_si256(year, _mm256_set1_epi32(3)), zero);
+            const __m256i sixteenthYear = _mm256_cmpeq_epi32(_mm256_and_si256(year, _mm256_set1_epi32(15)), zero);
+            const __m256i leap = _mm256_andnot_si256(_mm256_andnot_si256(sixteenthYear, centuryYear), fourthYear);
+
+            // daysInMonth() from the packed table, less one. The masks are -1, so subtracting one adds 1.
+            const __m256i leapDay = _mm256_and_si256(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(2)), leap);
+            const __m256i lastDay = _mm256_sub_epi32(_mm256_add_epi32(_mm256_set1_epi32(27),
+                _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(packedDaysInMonth)), _mm256_add_epi32(index, index)),
+                    _mm256_set1_epi32(3))), leapDay);
+
+            const __m256i dayIndex = _mm256_sub_epi32(day, one);
+            const __m256i dateValid = _mm256_and_si256(monthValid, atMost(dayIndex, lastDay));
+            const __m256i timeValid = _mm256_and_si256(atMost(hour, _mm256_set1_epi32(23)),
+                _mm256_and_si256(atMost(minute, _mm256_set1_epi32(59)), atMost(second, _mm256_set1_epi32(59))));
+            const __m256i lanesValid = _mm256_and_si256(dateValid, timeValid);
+
+            // days_from_civil(), with March as the first month. The year is offset by one era to stay positive,
+            // and the divisions are multiplies by reciprocals, exact for the years [0, 9999].
+            const __m256i marchYear = _mm256_add_epi32(_mm256_add_epi32(year, _mm256_set1_epi32(400)),
+                _mm256_cmpgt_epi32(_mm256_set1_epi32(3), index)); // January and February count in the year before
+            const __m256i era = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(marchYear, 4), _mm256_set1_epi32(1311)), 15);
+            const __m256i yoe = _mm256_sub_epi32(marchYear, _mm256_mullo_epi32(era, _mm256_set1_epi32(400)));
+            const __m256i marchMonth = _mm256_sub_epi32(_mm256_add_epi32(index, _mm256_set1_epi32(9)),
+                _mm256_and_si256(_mm256_cmpgt_epi32(index, _mm256_set1_epi32(2)), _mm256_set1_epi32(12)));
+            const __m256i doy = _mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(
+                _mm256_add_epi32(_mm256_mullo_epi32(marchMonth, _mm256_set1_epi32(153)), _mm256_set1_epi32(2)), _mm256_set1_epi32(52429)), 18),
+                dayIndex);
+            const __m256i doe = _mm256_add_epi32(_mm256_sub_epi32(_mm256_add_epi32(_mm256_mullo_epi32(yoe, _mm256_set1_epi32(365)),
+                _mm256_srli_epi32(yoe, 2)), _mm256_srli_epi32(_mm256_mullo_epi32(yoe, _mm256_set1_epi32(5243)), 19)), doy);
+            const __m256i days = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(era, one), _mm256_set1_epi32(146097)),
+                _mm256_sub_epi32(doe, _mm256_set1_epi32(719468)));
+
+            // The seconds of the day in UTC fit in 32 bits, the seconds since the epoch take 64
+            const __m256i daySeconds = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+                _mm256_mullo_epi32(hour, _mm256_set1_epi32(3600)), _mm256_mullo_epi32(minute, _mm256_set1_epi32(60))), second),
+                _mm256_mullo_epi32(differential, _mm256_set1_epi32(60)));
+
+            const __m256i secondsPerDay = _mm256_set1_epi64x(86400);
+            for(int half = 0; half < 2; ++half)
+            {
+                const __m128i halfDays = half ? _mm256_extracti128_si256(days, 1) : _mm256_castsi256_si128(days);
+                const __m128i halfSeconds = half ? _mm256_extracti128_si256(daySeconds, 1) : _mm256_castsi256_si128(daySeconds);
+                const __m128i halfValid = half ? _mm256_extracti128_si256(lanesValid, 1) : _mm256_castsi256_si128(lanesValid);
+
+                const __m256i seconds = _mm256_add_epi64(_mm256_mul_epi32(_mm256_cvtepi32_epi64(halfDays), secondsPerDay),
+                    _mm256_cvtepi32_epi64(halfSeconds));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(time + i + 4 * half),
+                    _mm256_and_si256(toClockTicks(seconds), _mm256_cvtepi32_epi64(halfValid)));
+            }
+
+            // 1 or 0 per date, narrowed to bytes
+            const __m256i flags = _mm256_and_si256(lanesValid, one);
+            const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(flags), _mm256_extracti128_si256(flags, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(valid + i), _mm_packs_epi16(words, words));
+
+            validCount += std::bitset<8>(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lanesValid)))).count();
+        }
+
+        return validCount + convertDateTimesScalar(dates + i, count - i, time + i, valid + i);
+    }
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include "rfc882calendar.h"
+#include "rfc882simd.h"
+
+#ifdef RFC882_SIMD_AVX512
+
+#include <bitset>
+
+#include <immintrin.h>
+
+// GCC 12 warns about the undefined source that many AVX-512 intrinsics start from.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace rfc882::detail
+{
+    namespace
+    {
+        // x * clockTicksPerSecond in 64-bit lanes, from two 32 x 32 bit products (AVX-512F has no 64-bit multiply)
+        RFC882_TARGET("avx512f")
+        __m512i toClockTicks(__m512i x) noexcept
+        {
+            const __m512i ticks = _mm512_set1_epi64(clockTicksPerSecond);
+            return _mm512_add_epi64(_mm512_mul_epu32(x, ticks),
+                _mm512_slli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x, 32), ticks), 32));
+        }
+    }
+
+    // The same arithmetic as convertDateTimesAVX2(), sixteen dates at a time with mask registers
+    RFC882_TARGET("avx512f")
+    std::size_t convertDateTimesAVX512(const RFC882DateTime::DateTime* dates, std::size_t count,
+        std::chrono::system_clock::time_point* time, std::uint8_t* valid) noexcept
+    {
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i one = _mm512_set1_epi32(1);
+
+        // Every eighth 32-bit field is the same field of the next date
+        const __m512i rows = _mm512_setr_epi32(0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120);
+
+        std::size_t validCount = 0;
+        std::size_t i = 0;
+        for(; i + 16 <= count; i += 16)
+        {
+            const RFC882DateTime::DateTime* block = dates + i;
+            const __m512i day = _mm512_i32gather_epi32(rows, &block->day, 4);
+            const __m512i month = _mm512_i32gather_epi32(rows, &block->month, 4);
+            const __m512i year = _mm512_i32gather_epi32(rows, &block->year, 4);
+            const __m512i hour = _mm512_i32gather_epi32(rows, &block->hour, 4);
+            const __m512i minute = _mm512_i32gather_epi32(rows, &block->minute, 4);
+            const __m512i second = _mm512_i32gather_epi32(rows, &block->second, 4);
+            const __m512i differential = _mm512_i32gather_epi32(rows, &block->timeZoneDifferential, 4);
+
+            // monthIndex()
+            const __mmask16 monthValid = _mm512_cmple_epu32_mask(_mm512_sub_epi32(month, one), _mm512_set1_epi32(11));
+            const __m512i index = _mm512_maskz_mov_epi32(monthValid, month);
+
+            // isLeapYear(), with year / 100 as a multiply by its reciprocal
+            const __m512i century = _mm512_srli_epi32(_mm512_mullo_epi32(year, _mm512_set1_epi32(5243)), 19);
+            const __mmask16 leap = _mm512_cmpeq_epi32_mask(_mm512_and_epi32(year, _mm512_set1_epi32(3)), zero) &
+                (_mm512_cmpneq_epi32_mask(year, _mm512_mullo_epi32(century, _mm512_set1_epi32(100))) |
+                _mm512_cmpeq_epi32_mask(_mm512_and_epi32(year, _mm512_set1_epi32(15)), zero));
+
+            // daysInMonth() from the packed table, less one
+            const __m512i commonLastDay = _mm512_add_epi32(_mm512_set1_epi32(27),
+                _mm512_and_epi32(_mm512_srlv_epi32(_mm512_set1_epi32(static_cast<int>(packedDaysInMonth)), _mm512_add_epi32(index, index)),
+                    _mm512_set1_epi32(3)));
+            const __m512i lastDay = _mm512_mask_add_epi32(commonLastDay,
+                leap & _mm512_cmpeq_epi32_mask(index, _mm512_set1_epi32(2)), commonLastDay, one);
+
+            const __m512i dayIndex = _mm512_sub_epi32(day, one);
+            const __mmask16 lanesValid = monthValid & _mm512_cmple_epu32_mask(dayIndex, lastDay) &
+                _mm512_cmple_epu32_mask(hour, _mm512_set1_epi32(23)) &
+                _mm512_cmple_epu32_mask(minute, _mm512_set1_epi32(59)) &
+                _mm512_cmple_epu32_mask(second, _mm512_set1_epi32(59));
+
+            // days_from_civil(), with March as the first month; see convertDateTimesAVX2()
+            const __m512i shiftedYear = _mm512_add_epi32(year, _mm512_set1_epi32(400));
+            const __m512i marchYear = _mm512_mask_sub_epi32(shiftedYear,
+                _mm512_cmple_epu32_mask(index, _mm512_set1_epi32(2)), shiftedYear, one); // January and February count in the year before
+            const __m512i era = _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_srli_epi32(marchYear, 4), _mm512_set1_epi32(1311)), 15);
+            const __m512i yoe = _mm512_sub_epi32(marchYear, _mm512_mullo_epi32(era, _mm512_set1_epi32(400)));
+            const __m512i shiftedMonth = _mm512_add_epi32(index, _mm512_set1_epi32(9));
+            const __m512i marchMonth = _mm512_mask_sub_epi32(shiftedMonth,
+                _mm512_cmpgt_epu32_mask(index, _mm512_set1_epi32(2)), shiftedMonth, _mm512_set1_epi32(12));
+            const __m512i doy = _mm512_add_epi32(_mm512_srli_epi32(_mm512_mullo_epi32(
+                _mm512_add_epi32(_mm512_mullo_epi32(marchMonth, _mm512_set1_epi32(153)), _mm512_set1_epi32(2)), _mm512_set1_epi32(52429)), 18),
+                dayIndex);
+            const __m512i doe = _mm512_add_epi32(_mm512_sub_epi32(_mm512_add_epi32(_mm512_mullo_epi32(yoe, _mm512_set1_epi32(365)),
+                _mm512_srli_epi32(yoe, 2)), _mm512_srli_epi32(_mm512_mullo_epi32(yoe, _mm512_set1_epi32(5243)), 19)), doy);
+            const __m512i days = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(era, one), _mm512_set1_epi32(146097)),
+                _mm512_sub_epi32(doe, _mm512_set1_epi32(719468)));
+
+            const __m512i daySeconds = _mm512_sub_epi32(_mm512_add_epi32(_mm512_add_epi32(
+                _mm512_mullo_epi32(hour, _mm512_set1_epi32(3600)), _mm512_mullo_epi32(minute, _mm512_set1_epi32(60))), second),
+                _mm512_mullo_epi32(differential, _mm512_set1_epi32(60)));
+
+            const __m512i secondsPerDay = _mm512_set1_epi64(86400);
+            for(int half = 0; half < 2; ++half)
+            {
+                const __m256i halfDays = half ? _mm512_extracti64x4_epi64(days, 1) : _mm512_castsi512_si256(days);
+                const __m256i halfSeconds = half ? _mm512_extracti64x4_epi64(daySeconds, 1) : _mm512_castsi512_si256(daySeconds);
+
+                const __m512i seconds = _mm512_add_epi64(_mm512_mul_epi32(_mm512_cvtepi32_epi64(halfDays), secondsPerDay),
+                    _mm512_cvtepi32_epi64(halfSeconds));
+                _mm512_storeu_si512(time + i + 8 * half,
+                    _mm512_maskz_mov_epi64(static_cast<__mmask8>(lanesValid >> (8 * half)), toClockTicks(seconds)));
+            }
+
+            // 1 or 0 per date, narrowed to bytes
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(valid + i), _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(lanesValid, one)));
+
+            validCount += std::bitset<16>(lanesValid).count();
+        }
+
+        return validCount + convertDateTimesScalar(dates + i, count - i, time + i, valid + i);
+    }
+}
+
+#endif
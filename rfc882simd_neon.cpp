@@ -0,0 +1,69 @@
+#include "rfc882simd.h"
+
+#ifdef RFC882_SIMD_NEON
+
+#include <arm_neon.h>
+
+namespace rfc882::detail
+{
+    namespace
+    {
+        // Per layout constants. The high register ends at the last byte of the stamp, so it starts
+        // at byte 15 (numeric zone) or 13 (named zone), and the tables below are relative to that.
+        struct NeonLayout
+        {
+            std::uint8_t hiSeparators[16];
+            std::uint8_t hiUnchecked[16];
+            std::uint8_t digitIndices[16];  // into { lo, hi } as a 32-byte table
+            std::uint8_t optionalDigits[16];
+        };
+
+        constexpr NeonLayout numericLayout{
+            { 0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, ' ', 0, 0, 0, 0, 0 },
+            { 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+            { 5, 6, 12, 13, 14, 15, 18, 19, 21, 22, 24, 25, 28, 29, 30, 31 },
+            { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+        };
+
+        constexpr NeonLayout namedLayout{
+            { 0, 0, 0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, ' ', 0, 0, 0 },
+            { 0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF },
+            { 5, 6, 12, 13, 14, 15, 20, 21, 23, 24, 26, 27, 0xFF, 0xFF, 0xFF, 0xFF },
+            { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF }
+        };
+
+        // Separators in the low register: bytes 3, 4, 7 and 11 (see fixedLayoutSeparators)
+        constexpr std::uint8_t loSeparators[16] = { 0, 0, 0, ',', ' ', 0, 0, ' ', 0, 0, 0, ' ', 0, 0, 0, 0 };
+        constexpr std::uint8_t loUnchecked[16] = { 0xFF, 0xFF, 0xFF, 0, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0xFF, 0xFF };
+    }
+
+    bool fixedLayoutNEON(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept
+    {
+        const NeonLayout& layout = numericZone ? numericLayout : namedLayout;
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(stamp);
+        const uint8x16x2_t halves{ { vld1q_u8(bytes), vld1q_u8(bytes + (numericZone ? 15 : 13)) } };
+
+        // Unchecked bytes are forced to "equal" by ORing in the mask
+        const uint8x16_t separatorsOk = vandq_u8(
+            vorrq_u8(vceqq_u8(halves.val[0], vld1q_u8(loSeparators)), vld1q_u8(loUnchecked)),
+            vorrq_u8(vceqq_u8(halves.val[1], vld1q_u8(layout.hiSeparators)), vld1q_u8(layout.hiUnchecked)));
+        if(vminvq_u8(separatorsOk) != 0xFF)
+            return false;
+
+        // Gather the 16 digits (see fixedLayoutDigitPairs) from both registers with one table lookup
+        const uint8x16_t digits = vsubq_u8(vqtbl2q_u8(halves, vld1q_u8(layout.digitIndices)), vdupq_n_u8('0'));
+
+        // The zone digits are only required in the numeric zone layout
+        const uint8x16_t digitsOk = vorrq_u8(vcleq_u8(digits, vdupq_n_u8(9)), vld1q_u8(layout.optionalDigits));
+        if(vminvq_u8(digitsOk) != 0xFF)
+            return false;
+
+        // tens * 10 + ones for each pair
+        const uint8x16_t tens = vuzp1q_u8(digits, digits);
+        const uint8x16_t ones = vuzp2q_u8(digits, digits);
+        vst1_u8(pairs, vmla_u8(vget_low_u8(ones), vget_low_u8(tens), vdup_n_u8(10)));
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,49 @@
+#include "rfc882simd.h"
+
+#ifdef RFC882_SIMD_X86
+
+#include <immintrin.h>
+
+namespace rfc882::detail
+{
+    RFC882_TARGET("ssse3")
+    bool fixedLayoutSSSE3(const char* stamp, bool numericZone, std::uint8_t* pairs) noexcept
+    {
+        // The high half ends at the last byte, so it starts at byte 15 (numeric zone) or 13 (named zone)
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stamp));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stamp + (numericZone ? 15 : 13)));
+
+        // Separators (see fixedLayoutSeparators): bytes 3, 4, 7, 11 in the low half, 16, 19, 22, 25 in the high half
+        const __m128i loSeparators = _mm_setr_epi8(0, 0, 0, ',', ' ', 0, 0, ' ', 0, 0, 0, ' ', 0, 0, 0, 0);
+        const __m128i hiSeparators = numericZone ?
+            _mm_setr_epi8(0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, ' ', 0, 0, 0, 0, 0) :
+            _mm_setr_epi8(0, 0, 0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, ' ', 0, 0, 0);
+        constexpr int loSeparatorMask = (1 << 3) | (1 << 4) | (1 << 7) | (1 << 11);
+        const int hiSeparatorMask = ((1 << 0) | (1 << 3) | (1 << 6) | (1 << 9)) << (numericZone ? 1 : 3);
+        if((_mm_movemask_epi8(_mm_cmpeq_epi8(lo, loSeparators)) & loSeparatorMask) != loSeparatorMask ||
+            (_mm_movemask_epi8(_mm_cmpeq_epi8(hi, hiSeparators)) & hiSeparatorMask) != hiSeparatorMask)
+            return false;
+
+        // Gather the 16 digits (see fixedLayoutDigitPairs) into one register; -1 selects zero
+        const __m128i loDigits = _mm_setr_epi8(5, 6, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i hiDigits = numericZone ?
+            _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 3, 5, 6, 8, 9, 12, 13, 14, 15) :
+            _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1);
+        const __m128i digits = _mm_sub_epi8(
+            _mm_or_si128(_mm_shuffle_epi8(lo, loDigits), _mm_shuffle_epi8(hi, hiDigits)),
+            _mm_set1_epi8('0'));
+
+        // A byte is a digit if it is unchanged by an unsigned min with 9
+        const int digitMask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits));
+        const int requiredDigits = numericZone ? 0xFFFF : 0x0FFF;
+        if((digitMask & requiredDigits) != requiredDigits)
+            return false;
+
+        // tens * 10 + ones for each pair, then narrow to bytes
+        const __m128i values = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pairs), _mm_packus_epi16(values, values));
+        return true;
+    }
+}
+
+#endif
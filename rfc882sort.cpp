@@ -0,0 +1,118 @@
+#include <algorithm> // for std::copy()
+#include <array>
+#include <utility> // for std::swap()
+#include <vector>
+
+#include "rfc882sort.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        constexpr std::size_t radixPasses = 8;
+        constexpr std::size_t insertionSortLimit = 64;
+
+        using Histogram = std::array<std::size_t, 256>;
+
+        // Small inputs aren't worth the histograms
+        void insertionSort(std::uint64_t* keys, std::uint32_t* values, std::size_t count) noexcept
+        {
+            for(std::size_t i = 1; i < count; ++i)
+            {
+                const std::uint64_t key = keys[i];
+                const std::uint32_t value = values ? values[i] : 0;
+                std::size_t j = i;
+                for(; j > 0 && keys[j - 1] > key; --j)
+                {
+                    keys[j] = keys[j - 1];
+                    if(values)
+                        values[j] = values[j - 1];
+                }
+                keys[j] = key;
+                if(values)
+                    values[j] = value;
+            }
+        }
+
+        void sortKeysAndValues(std::uint64_t* keys, std::uint32_t* values, std::size_t count)
+        {
+            if(count < insertionSortLimit)
+            {
+                insertionSort(keys, values, count);
+                return;
+            }
+
+            // All histograms in one read of the keys
+            std::vector<Histogram> histograms(radixPasses, Histogram{});
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                for(std::size_t pass = 0; pass < radixPasses; ++pass)
+                    ++histograms[pass][(keys[i] >> (8 * pass)) & 0xFF];
+            }
+
+            std::vector<std::uint64_t> keyScratch(count);
+            std::vector<std::uint32_t> valueScratch(values ? count : 0);
+            std::uint64_t* keysFrom = keys;
+            std::uint64_t* keysTo = keyScratch.data();
+            std::uint32_t* valuesFrom = values;
+            std::uint32_t* valuesTo = values ? valueScratch.data() : nullptr;
+
+            for(std::size_t pass = 0; pass < radixPasses; ++pass)
+            {
+                const unsigned shift = static_cast<unsigned>(8 * pass);
+                Histogram& histogram = histograms[pass];
+
+                // Every key has the same byte here, so this pass wouldn't move anything
+                if(histogram[(keysFrom[0] >> shift) & 0xFF] == count)
+                    continue;
+
+                std::size_t offset = 0;
+                for(auto& bucket : histogram)
+                {
+                    const std::size_t size = bucket;
+                    bucket = offset;
+                    offset += size;
+                }
+
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    const std::size_t to = histogram[(keysFrom[i] >> shift) & 0xFF]++;
+                    keysTo[to] = keysFrom[i];
+                    if(values)
+                        valuesTo[to] = valuesFrom[i];
+                }
+                std::swap(keysFrom, keysTo);
+                std::swap(valuesFrom, valuesTo);
+            }
+
+            // An odd number of passes leaves the result in the scratch space
+            if(keysFrom != keys)
+            {
+                std::copy(keysFrom, keysFrom + count, keys);
+                if(values)
+                    std::copy(valuesFrom, valuesFrom + count, values);
+            }
+        }
+    }
+
+    std::uint64_t sortKey(std::string_view stamp) noexcept
+    {
+        return sortKey(parse(stamp));
+    }
+
+    void sortKeys(const std::string_view* stamps, std::size_t count, std::uint64_t* keys) noexcept
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            keys[i] = sortKey(parse(stamps[i]));
+    }
+
+    void radixSort(std::uint64_t* keys, std::size_t count)
+    {
+        sortKeysAndValues(keys, nullptr, count);
+    }
+
+    void radixSort(std::uint64_t* keys, std::uint32_t* values, std::size_t count)
+    {
+        sortKeysAndValues(keys, values, count);
+    }
+}
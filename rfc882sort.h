@@ -0,0 +1,73 @@
+#ifndef RFC882SORT_H
+#define RFC882SORT_H
+
+/*
+Sorting by date without keeping parsed structures around.
+
+sortKey() packs the parsed time of a stamp into a 64-bit integer whose unsigned order is the time
+order, so stamps can be sorted and deduplicated as plain integers:
+
+    bits 63 - 16    UTC seconds since 1970-01-01, biased by 2^47 so that earlier times compare lower
+    bits 15 - 0     time zone differential in minutes, biased by 2^15: the tiebreak between stamps
+                    that denote the same instant in different zones (western zones first)
+
+Stamps that don't parse get invalidSortKey (0), which sorts before every valid key.
+Sub-second precision doesn't exist in the format, so nothing is lost.
+
+radixSort() sorts keys (optionally carrying a 32-bit payload, such as the index of each item) with an
+LSD radix sort that skips the byte positions in which all keys agree. Stamps from a limited time span
+share their top bytes, so typically only 4 or 5 of the 8 passes are run.
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882calendar.h"
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    constexpr std::uint64_t invalidSortKey = 0;
+
+    // The sort key of a parse() result.
+    constexpr std::uint64_t sortKey(const ParseResult& result) noexcept
+    {
+        if(!result)
+            return invalidSortKey;
+
+        // From the fields rather than result.time, which can't represent every 4-digit year
+        const auto& date = result.dateTime;
+        const std::int64_t days = days_from_civil<std::int64_t>(date.year, static_cast<unsigned>(date.month), static_cast<unsigned>(date.day));
+        const std::int64_t seconds = ((days * 24 + date.hour) * 60 + date.minute - date.timeZoneDifferential.count()) * 60 + date.second;
+        const std::uint64_t biasedSeconds = static_cast<std::uint64_t>(seconds + (std::int64_t{ 1 } << 47));
+        const std::uint64_t biasedDifferential = static_cast<std::uint64_t>(result.dateTime.timeZoneDifferential.count() + (1 << 15)) & 0xFFFF;
+        return (biasedSeconds << 16) | biasedDifferential;
+    }
+
+    // The sort key of stamp, or invalidSortKey if it doesn't parse.
+    std::uint64_t sortKey(std::string_view stamp) noexcept;
+
+    // Write the sort keys of count stamps into keys.
+    void sortKeys(const std::string_view* stamps, std::size_t count, std::uint64_t* keys) noexcept;
+
+    // Decode a valid key. The time must be representable by system_clock::time_point.
+    constexpr std::chrono::system_clock::time_point sortKeyTime(std::uint64_t key) noexcept
+    {
+        const std::int64_t seconds = static_cast<std::int64_t>(key >> 16) - (std::int64_t{ 1 } << 47);
+        return std::chrono::system_clock::time_point{ std::chrono::seconds{ seconds } };
+    }
+
+    constexpr std::chrono::minutes sortKeyDifferential(std::uint64_t key) noexcept
+    {
+        return std::chrono::minutes{ static_cast<int>(key & 0xFFFF) - (1 << 15) };
+    }
+
+    // Sort keys in ascending order. The sort is stable; with values, values[i] moves along with keys[i].
+    // Allocates scratch space of the same size as the input.
+    void radixSort(std::uint64_t* keys, std::size_t count);
+    void radixSort(std::uint64_t* keys, std::uint32_t* values, std::size_t count);
+}
+
+#endif
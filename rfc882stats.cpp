@@ -0,0 +1,220 @@
+#include <atomic>
+#include <mutex>
+#include <new> // for placement new
+
+#include "rfc882stats.h"
+
+namespace rfc882
+{
+    namespace
+    {
+        // Call f on every counter of stats, in declaration order
+        template <class Stats, class F>
+        void forEachCounter(Stats& stats, F f)
+        {
+            f(stats.stamps);
+            f(stats.parsed);
+            f(stats.fixedLayout);
+            f(stats.numericZone);
+            f(stats.twoDigitYear);
+            f(stats.withoutSeconds);
+            f(stats.withoutWeekday);
+            for(auto& counter : stats.rejections)
+                f(counter);
+            f(stats.latencySamples);
+            for(auto& counter : stats.latency)
+                f(counter);
+        }
+
+        // The index of each counter in forEachCounter() order
+        enum Counter : std::size_t
+        {
+            stampsCounter,
+            parsedCounter,
+            fixedLayoutCounter,
+            numericZoneCounter,
+            twoDigitYearCounter,
+            withoutSecondsCounter,
+            withoutWeekdayCounter,
+            rejectionsCounter,
+            latencySamplesCounter = rejectionsCounter + parseErrorCount,
+            latencyCounter,
+            counterCount = latencyCounter + latencyBucketCount
+        };
+
+        static_assert(sizeof(ParseStats) == counterCount * sizeof(std::uint64_t), "Every counter of ParseStats must be in forEachCounter()");
+
+        // Only the owning thread writes its counters, so it can increment them with a plain load and store.
+        // They are atomic so that aggregateParseStats() can read them at the same time.
+        struct ThreadCounters
+        {
+            std::atomic<std::uint64_t> counters[counterCount] = {};
+            std::uint32_t sinceSample = 0;
+
+            // The other live threads, linked under the mutex of the Registry
+            ThreadCounters* previous = nullptr;
+            ThreadCounters* next = nullptr;
+
+            void increment(std::size_t counter) noexcept
+            {
+                counters[counter].store(counters[counter].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            ParseStats stats() const noexcept
+            {
+                ParseStats stats;
+                std::size_t counter = 0;
+                forEachCounter(stats, [&](std::uint64_t& value) { value = counters[counter++].load(std::memory_order_relaxed); });
+                return stats;
+            }
+        };
+
+        // The counters of the live threads, as an intrusive list so that registering a thread can't fail,
+        // and the sum of those of the exited ones
+        struct Registry
+        {
+            std::mutex mutex;
+            ThreadCounters* threads = nullptr;
+            ParseStats exited;
+        };
+
+        // Never destroyed, so threads that exit after main() returns can still unregister, and not allocated,
+        // so that the first parse() of a thread can't throw
+        Registry& registry() noexcept
+        {
+            alignas(Registry) static unsigned char storage[sizeof(Registry)];
+            static Registry* const instance = new(storage) Registry;
+            return *instance;
+        }
+
+        struct ThreadRegistration
+        {
+            ThreadCounters counters;
+
+            ThreadRegistration() noexcept
+            {
+                Registry& all = registry();
+                const std::lock_guard<std::mutex> lock{ all.mutex };
+                counters.next = all.threads;
+                if(all.threads)
+                    all.threads->previous = &counters;
+                all.threads = &counters;
+            }
+
+            ~ThreadRegistration()
+            {
+                Registry& all = registry();
+                const std::lock_guard<std::mutex> lock{ all.mutex };
+                all.exited += counters.stats();
+                if(counters.previous)
+                    counters.previous->next = counters.next;
+                else
+                    all.threads = counters.next;
+                if(counters.next)
+                    counters.next->previous = counters.previous;
+            }
+        };
+
+        ThreadCounters& threadCounters() noexcept
+        {
+            thread_local ThreadRegistration registration;
+            return registration.counters;
+        }
+
+        std::atomic<std::uint32_t> latencySamplingPeriod{ 0 };
+    }
+
+    ParseStats& operator+=(ParseStats& x, const ParseStats& y) noexcept
+    {
+        std::array<std::uint64_t, counterCount> values;
+        std::size_t counter = 0;
+        forEachCounter(y, [&](const std::uint64_t& value) { values[counter++] = value; });
+        counter = 0;
+        forEachCounter(x, [&](std::uint64_t& value) { value += values[counter++]; });
+        return x;
+    }
+
+    ParseStats parseStats() noexcept
+    {
+        if constexpr(!parseStatsEnabled)
+            return {};
+        return threadCounters().stats();
+    }
+
+    ParseStats aggregateParseStats() noexcept
+    {
+        if constexpr(!parseStatsEnabled)
+            return {};
+
+        Registry& all = registry();
+        const std::lock_guard<std::mutex> lock{ all.mutex };
+        ParseStats stats = all.exited;
+        for(const ThreadCounters* thread = all.threads; thread; thread = thread->next)
+            stats += thread->stats();
+        return stats;
+    }
+
+    void resetParseStats() noexcept
+    {
+        if constexpr(!parseStatsEnabled)
+            return;
+
+        for(auto& counter : threadCounters().counters)
+            counter.store(0, std::memory_order_relaxed);
+    }
+
+    void setLatencySampling(std::uint32_t period) noexcept
+    {
+        latencySamplingPeriod.store(period, std::memory_order_relaxed);
+    }
+
+    namespace detail
+    {
+        bool sampleParse() noexcept
+        {
+            const std::uint32_t period = latencySamplingPeriod.load(std::memory_order_relaxed);
+            if(period == 0)
+                return false;
+
+            ThreadCounters& local = threadCounters();
+            if(++local.sinceSample < period)
+                return false;
+            local.sinceSample = 0;
+            return true;
+        }
+
+        void recordParse(std::string_view stamp, const ParseResult& result, bool fixedLayout, std::chrono::nanoseconds latency) noexcept
+        {
+            ThreadCounters& local = threadCounters();
+            local.increment(stampsCounter);
+            if(fixedLayout)
+                local.increment(fixedLayoutCounter);
+
+            if(latency.count() >= 0)
+            {
+                std::size_t bucket = 0;
+                while(bucket + 1 < latencyBucketCount && (latency.count() >> (bucket + 1)) != 0)
+                    ++bucket;
+                local.increment(latencySamplesCounter);
+                local.increment(latencyCounter + bucket);
+            }
+
+            if(!result)
+            {
+                local.increment(rejectionsCounter + static_cast<std::size_t>(result.error));
+                return;
+            }
+
+            local.increment(parsedCounter);
+            const char zone = stamp[result.tokens.timeZone.offset];
+            if(zone == '+' || zone == '-')
+                local.increment(numericZoneCounter);
+            if(result.tokens.year.length == 2)
+                local.increment(twoDigitYearCounter);
+            if(result.tokens.second.length == 0)
+                local.increment(withoutSecondsCounter);
+            if(result.tokens.dayOfWeek.length == 0)
+                local.increment(withoutWeekdayCounter);
+        }
+    }
+}
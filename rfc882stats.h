@@ -0,0 +1,83 @@
+#ifndef RFC882STATS_H
+#define RFC882STATS_H
+
+/*
+Optional counters of what parse() sees, for finding out in production which paths the stamps take:
+the fast path or the scanner, named zones or differentials, 2- or 4-digit years, missing seconds and
+weekdays, and why stamps are rejected. A sampled latency histogram can be turned on as well.
+
+The counters are compiled in only when RFC882_ENABLE_STATS is defined (for every translation unit of
+the build). Otherwise the hooks compile to nothing, and the functions below return zeros.
+
+    rfc882::setLatencySampling(1024); // time one parse in 1024
+    ...
+    const rfc882::ParseStats stats = rfc882::aggregateParseStats();
+
+Each thread counts into its own counters, without locks or atomic read-modify-writes, and
+aggregateParseStats() sums them on demand, including those of threads that have exited.
+parse(), parseBatch() and everything built on them are counted. parseCached() hits and BasicParser,
+which is constexpr, are not.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+#ifdef RFC882_ENABLE_STATS
+    inline constexpr bool parseStatsEnabled = true;
+#else
+    inline constexpr bool parseStatsEnabled = false;
+#endif
+
+    // Bucket i of the latency histogram counts parses of [2^i, 2^(i + 1)) ns; the last one also counts the slower ones.
+    constexpr std::size_t latencyBucketCount = 16;
+
+    struct ParseStats
+    {
+        std::uint64_t stamps = 0;                   // Stamps given to parse()
+        std::uint64_t parsed = 0;                   // Of which parsed
+        std::uint64_t fixedLayout = 0;              // Stamps that the fixed-layout fast path took (rfc882simd.h)
+
+        // The shape of the stamps that parsed
+        std::uint64_t numericZone = 0;              // A differential such as +0130; the others have a zone name
+        std::uint64_t twoDigitYear = 0;             // The others have 4 digits
+        std::uint64_t withoutSeconds = 0;
+        std::uint64_t withoutWeekday = 0;
+
+        std::array<std::uint64_t, parseErrorCount> rejections{}; // The stamps that didn't parse, by ParseError
+
+        std::uint64_t latencySamples = 0;           // Parses that were timed
+        std::array<std::uint64_t, latencyBucketCount> latency{};
+    };
+
+    ParseStats& operator+=(ParseStats& x, const ParseStats& y) noexcept;
+
+    // The counters of the calling thread.
+    ParseStats parseStats() noexcept;
+
+    // The counters of every thread, including those that have exited.
+    ParseStats aggregateParseStats() noexcept;
+
+    // Reset the counters of the calling thread.
+    void resetParseStats() noexcept;
+
+    // Time one parse() in every period on each thread, or none if period is 0 (the default).
+    void setLatencySampling(std::uint32_t period) noexcept;
+
+    namespace detail
+    {
+        // Whether the calling thread should time its next parse.
+        bool sampleParse() noexcept;
+
+        // Count a stamp. fixedLayout is true if the fast path took it, and latency is negative if it wasn't timed.
+        void recordParse(std::string_view stamp, const ParseResult& result, bool fixedLayout, std::chrono::nanoseconds latency) noexcept;
+    }
+}
+
+#endif
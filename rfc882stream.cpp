@@ -0,0 +1,329 @@
+#include "rfc882calendar.h"
+#include "rfc882scanner.h"
+#include "rfc882stream.h"
+#include "rfc882tables.h"
+
+namespace rfc882
+{
+    // Same grammar as detail::scanDateAndTimeSpec(), one byte at a time.
+    // Every state records where its token started in token_, and finished tokens are stored in result_.
+    void StreamParser::consume(std::string_view bytes) noexcept
+    {
+        for(std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            if(state_ == State::failed)
+            {
+                // Nothing more to scan until the delimiter
+                length_ += bytes.size() - i;
+                return;
+            }
+
+            const char c = bytes[i];
+            const bool space = detail::isSpace(c);
+            const bool digit = detail::isDigit(c);
+            State next = State::failed;
+            switch(state_)
+            {
+            // [ day "," ]
+            case State::start:
+                if(space)
+                    next = State::beforeDay;
+                else
+                {
+                    beginToken(digit ? State::day : State::weekday, c);
+                    next = state_;
+                }
+                break;
+
+            case State::weekday:
+                if(token_.length < 3)
+                {
+                    name_[token_.length++] = c;
+                    next = State::weekday;
+                }
+                else if(c == ',' && weekdayFromName({ name_, 3 }) >= 0)
+                {
+                    result_.tokens.dayOfWeek = token_;
+                    next = State::beforeDay;
+                }
+                break;
+
+            // date = 1*2DIGIT month 2DIGIT (2-4 digits here)
+            case State::beforeDay:
+                if(space)
+                    next = State::beforeDay;
+                else if(digit)
+                {
+                    beginToken(State::day, c);
+                    next = state_;
+                }
+                break;
+
+            case State::day:
+                if(digit && token_.length < 2)
+                {
+                    value_ = value_ * 10 + (c - '0');
+                    ++token_.length;
+                    next = State::day;
+                }
+                else if(space)
+                {
+                    result_.tokens.day = token_;
+                    result_.dateTime.day = value_;
+                    next = State::afterDay;
+                }
+                break;
+
+            case State::afterDay:
+                if(space)
+                    next = State::afterDay;
+                else
+                {
+                    beginToken(State::month, c);
+                    next = state_;
+                }
+                break;
+
+            case State::month:
+                name_[token_.length++] = c;
+                if(token_.length < 3)
+                    next = State::month;
+                else if((result_.dateTime.month = monthFromName({ name_, 3 })) != 0)
+                {
+                    result_.tokens.month = token_;
+                    next = State::monthEnd;
+                }
+                break;
+
+            case State::monthEnd:
+                if(space)
+                    next = State::afterMonth;
+                break;
+
+            case State::afterMonth:
+                if(space)
+                    next = State::afterMonth;
+                else if(digit)
+                {
+                    beginToken(State::year, c);
+                    next = state_;
+                }
+                break;
+
+            case State::year:
+                if(digit && token_.length < 4)
+                {
+                    value_ = value_ * 10 + (c - '0');
+                    ++token_.length;
+                    next = State::year;
+                }
+                else if(space && token_.length >= 2)
+                {
+                    result_.tokens.year = token_;
+                    result_.dateTime.year = (value_ < 100) ? value_ + 2000 : value_; // assume year 2000+
+                    next = State::afterYear;
+                }
+                break;
+
+            // hour = 2DIGIT ":" 2DIGIT [":" 2DIGIT]
+            case State::afterYear:
+                if(space)
+                    next = State::afterYear;
+                else if(digit)
+                {
+                    beginToken(State::hour, c);
+                    next = state_;
+                }
+                break;
+
+            case State::hour:
+                if(digit && token_.length < 2)
+                {
+                    value_ = value_ * 10 + (c - '0');
+                    ++token_.length;
+                    next = State::hour;
+                }
+                else if(c == ':' && token_.length == 2)
+                {
+                    result_.tokens.hour = token_;
+                    result_.dateTime.hour = value_;
+                    token_ = { static_cast<std::uint32_t>(length_ + 1), 0 };
+                    value_ = 0;
+                    next = State::minute;
+                }
+                break;
+
+            case State::minute:
+            case State::second:
+                if(digit && token_.length < 2)
+                {
+                    value_ = value_ * 10 + (c - '0');
+                    ++token_.length;
+                    next = state_;
+                }
+                else if(token_.length == 2 && state_ == State::minute && (space || c == ':'))
+                {
+                    result_.tokens.minute = token_;
+                    result_.dateTime.minute = value_;
+                    token_ = { static_cast<std::uint32_t>(length_ + 1), 0 };
+                    value_ = 0;
+                    next = space ? State::afterTime : State::second;
+                }
+                else if(token_.length == 2 && state_ == State::second && space)
+                {
+                    result_.tokens.second = token_;
+                    result_.dateTime.second = value_;
+                    next = State::afterTime;
+                }
+                break;
+
+            // zone, which runs to the end of the stamp and is checked by complete()
+            case State::afterTime:
+                if(space)
+                    next = State::afterTime;
+                else
+                {
+                    beginToken((c == '+' || c == '-') ? State::zoneNumeric : State::zoneName, c);
+                    sign_ = (c == '-') ? -1 : 1;
+                    value_ = 0;
+                    next = state_;
+                }
+                break;
+
+            case State::zoneNumeric:
+                if(digit && token_.length < 5)
+                {
+                    value_ = value_ * 10 + (c - '0');
+                    ++token_.length;
+                    next = State::zoneNumeric;
+                }
+                break;
+
+            case State::zoneName:
+                // Longer names can't be in the zone table
+                if(token_.length < sizeof(name_))
+                {
+                    name_[token_.length++] = c;
+                    next = State::zoneName;
+                }
+                break;
+
+            case State::failed:
+                break;
+            }
+
+            if(next == State::failed)
+                fail(c);
+            state_ = next;
+            ++length_;
+        }
+    }
+
+    // Where scanDateAndTimeSpec() would have stopped, and why
+    void StreamParser::fail(char c) noexcept
+    {
+        ParseError error = ParseError::badDay;
+        std::size_t offset = length_;
+        switch(state_)
+        {
+        case State::start:
+        case State::day:
+            break;
+
+        case State::weekday:
+            if(detail::isAsciiLetter(name_[0]))
+                error = ParseError::badWeekday;
+            offset = token_.offset;
+            break;
+
+        case State::beforeDay:
+            if(result_.tokens.dayOfWeek.length == 0 && detail::isAsciiLetter(c))
+                error = ParseError::badWeekday;
+            break;
+
+        case State::afterDay:
+        case State::monthEnd:
+            error = ParseError::badMonth;
+            break;
+
+        case State::month:
+            error = ParseError::badMonth;
+            offset = token_.offset;
+            break;
+
+        case State::afterMonth:
+        case State::year:
+            error = ParseError::badYear;
+            break;
+
+        case State::afterYear:
+        case State::hour:
+        case State::minute:
+        case State::second:
+            error = ParseError::badTime;
+            break;
+
+        case State::afterTime:
+            error = ParseError::badZone;
+            break;
+
+        case State::zoneNumeric:
+        case State::zoneName:
+            error = ParseError::badZone;
+            offset = token_.offset;
+            break;
+
+        case State::failed:
+            return; // Already recorded
+        }
+
+        result_.error = error;
+        result_.errorOffset = static_cast<std::uint32_t>(offset);
+    }
+
+    ParseResult StreamParser::complete() noexcept
+    {
+        bool scanned = false;
+        if(state_ == State::zoneNumeric && token_.length == 5)
+        {
+            // HHMM, where the minutes are not range checked (same as the reference implementation)
+            result_.dateTime.timeZoneDifferential = std::chrono::minutes{ sign_ * ((value_ / 100) * 60 + value_ % 100) };
+            scanned = true;
+        }
+        else if(state_ == State::zoneName)
+        {
+            scanned = timeZoneFromName({ name_, token_.length }, result_.dateTime.timeZoneDifferential);
+        }
+        result_.tokens.timeZone = token_;
+        if(!scanned)
+            fail('\0');
+
+        ParseResult result = result_;
+        reset();
+
+        if(!scanned || !detail::checkBounds(result))
+            return detail::rejection(result);
+
+        result.time = generateUTCTime(result.dateTime);
+        result.valid = true;
+        return result;
+    }
+
+    void StreamParser::reset() noexcept
+    {
+        result_ = ParseResult{};
+        token_ = TokenSpan{};
+        length_ = 0;
+        value_ = 0;
+        sign_ = 1;
+        state_ = State::start;
+    }
+
+    void StreamParser::beginToken(State state, char c) noexcept
+    {
+        token_ = { static_cast<std::uint32_t>(length_), 1 };
+        value_ = c - '0';
+        name_[0] = c;
+        state_ = state;
+    }
+}
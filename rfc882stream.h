@@ -0,0 +1,106 @@
+#ifndef RFC882STREAM_H
+#define RFC882STREAM_H
+
+/*
+Push parser for stamps arriving in arbitrary chunks, such as recv() buffers or windows of a mapped file.
+
+The stream is a sequence of stamps separated by a delimiter ('\n' by default). Every stamp is reported
+to the callback as the ParseResult that parse() would return for it, with the tokens relative to the
+start of the stamp. Stamps that lie entirely within one chunk are parsed in place. A stamp that
+straddles chunks is scanned incrementally, keeping the grammar state between them, so it is never
+copied or reassembled.
+
+    rfc882::StreamParser parser;
+    while(std::size_t size = read(buffer))
+        parser.feed({ buffer, size }, [](const rfc882::ParseResult& result) { ... });
+    parser.finish([](const rfc882::ParseResult& result) { ... });
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "rfc882datetime.h"
+
+namespace rfc882
+{
+    class StreamParser
+    {
+    public:
+        explicit StreamParser(char delimiter = '\n') noexcept : delimiter_{ delimiter } {}
+
+        // Feed the next chunk of the stream. onStamp(const ParseResult&) is called for every stamp
+        // completed by a delimiter in this chunk, including empty ones (which never parse).
+        template <class Callback>
+        void feed(std::string_view chunk, Callback&& onStamp)
+        {
+            while(!chunk.empty())
+            {
+                const std::size_t end = chunk.find(delimiter_);
+                if(end == std::string_view::npos)
+                {
+                    consume(chunk);
+                    return;
+                }
+
+                if(!pending())
+                {
+                    onStamp(parse(chunk.substr(0, end)));
+                }
+                else
+                {
+                    consume(chunk.substr(0, end));
+                    onStamp(complete());
+                }
+                chunk.remove_prefix(end + 1);
+            }
+        }
+
+        // End the stream: the bytes after the last delimiter, if any, are reported as a last stamp.
+        template <class Callback>
+        void finish(Callback&& onStamp)
+        {
+            if(pending())
+                onStamp(complete());
+        }
+
+        // Drop the unfinished stamp, if any.
+        void reset() noexcept;
+
+        // true if bytes of an unfinished stamp have been fed.
+        bool pending() const noexcept { return length_ != 0; }
+
+        char delimiter() const noexcept { return delimiter_; }
+
+    private:
+        enum class State : std::uint8_t
+        {
+            start, weekday, beforeDay, day, afterDay, month, monthEnd, afterMonth, year, afterYear,
+            hour, minute, second, afterTime, zoneNumeric, zoneName, failed
+        };
+
+        // Continue scanning the unfinished stamp over bytes, which contain no delimiter.
+        void consume(std::string_view bytes) noexcept;
+
+        // Finish the unfinished stamp and start over.
+        ParseResult complete() noexcept;
+
+        // Record the error for byte c, at offset length_, not fitting in state_.
+        // c is 0 when the stamp ended before it was complete.
+        void fail(char c) noexcept;
+
+        // Start the next token at byte c, which is at offset length_
+        void beginToken(State state, char c) noexcept;
+
+        ParseResult result_;
+        TokenSpan token_;               // The token being scanned
+        std::size_t length_ = 0;        // Bytes of the unfinished stamp so far
+        int value_ = 0;                 // Digits of the token being scanned
+        int sign_ = 1;                  // Of a numeric zone
+        char name_[8] = {};             // Characters of the name being scanned
+        State state_ = State::start;
+        char delimiter_;
+    };
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef RFC882TABLES_H
+#define RFC882TABLES_H
+
+/*
+Compile-time lookup tables for the names used in RFC882 stamps: months, days of the week and time zones.
+
+Names of up to 8 characters are packed into a 64-bit key, and each table places its keys with a
+multiplicative hash whose multiplier is searched for at compile time so that every name gets its own
+slot. A lookup is then a pack, a multiply and one compare. If no collision-free multiplier exists
+(only conceivable for large custom tables), the table falls back to short linear probing, bounded by
+maxProbe().
+
+NameTable is public so that extended zone tables can be built the same way:
+
+    constexpr auto europeanZones = rfc882::makeNameTable<std::int16_t>({ { "CET", 60 }, { "CEST", 120 } });
+*/
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace rfc882
+{
+    // Pack a name of 1 to 8 characters into an integer, first character in the lowest byte.
+    // Returns 0 (which is never a valid key) for names that are empty or too long, and for names that
+    // end in '\0', which would otherwise get the key of the name without it ("GMT\0" that of "GMT").
+    constexpr std::uint64_t packName(std::string_view name) noexcept
+    {
+        if(name.empty() || name.size() > 8 || name.back() == '\0')
+            return 0;
+
+        std::uint64_t key = 0;
+        for(std::size_t i = 0; i < name.size(); ++i)
+            key |= static_cast<std::uint64_t>(static_cast<unsigned char>(name[i])) << (8 * i);
+        return key;
+    }
+
+    template <class Value>
+    struct NameEntry
+    {
+        std::string_view name;
+        Value value;
+    };
+
+    template <class Value, std::size_t N>
+    class NameTable
+    {
+    public:
+        // Names must be unique, 1 to 8 characters long and must not contain '\0'.
+        constexpr explicit NameTable(const NameEntry<Value> (&entries)[N]) noexcept
+        {
+            std::uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+            std::uint64_t bestMultiplier = multiplier;
+            std::size_t bestProbe = capacity + 1;
+
+            for(std::size_t attempt = 0; attempt < maxAttempts && bestProbe > 1; ++attempt)
+            {
+                const std::size_t probe = place(entries, multiplier);
+                if(probe < bestProbe)
+                {
+                    bestProbe = probe;
+                    bestMultiplier = multiplier;
+                }
+
+                // Next odd multiplier from a 64-bit LCG
+                multiplier = (multiplier * 6364136223846793005ull + 1442695040888963407ull) | 1;
+            }
+
+            multiplier_ = bestMultiplier;
+            maxProbe_ = place(entries, bestMultiplier);
+        }
+
+        constexpr std::optional<Value> find(std::string_view name) const noexcept
+        {
+            const std::uint64_t key = packName(name);
+            if(key == 0)
+                return std::nullopt;
+
+            std::size_t slot = slotOf(key, multiplier_);
+            for(std::size_t probe = 0; probe < maxProbe_; ++probe)
+            {
+                if(slots_[slot].key == key)
+                    return slots_[slot].value;
+                slot = (slot + 1) & (capacity - 1);
+            }
+            return std::nullopt;
+        }
+
+        static constexpr std::size_t size() noexcept { return N; }
+
+        // 1 when the hash is perfect.
+        constexpr std::size_t maxProbe() const noexcept { return maxProbe_; }
+
+    private:
+        static constexpr std::size_t ceilPow2(std::size_t n) noexcept
+        {
+            std::size_t result = 1;
+            while(result < n)
+                result *= 2;
+            return result;
+        }
+
+        static constexpr std::size_t log2(std::size_t n) noexcept
+        {
+            std::size_t result = 0;
+            while(n > 1)
+            {
+                n /= 2;
+                ++result;
+            }
+            return result;
+        }
+
+        // A load factor of at most 1/4 keeps collision-free multipliers easy to find.
+        static constexpr std::size_t capacity = ceilPow2(N * 4 < 8 ? 8 : N * 4);
+        static constexpr std::size_t shift = 64 - log2(capacity);
+        static constexpr std::size_t maxAttempts = 4096;
+
+        struct Slot
+        {
+            std::uint64_t key = 0;
+            Value value{};
+        };
+
+        static constexpr std::size_t slotOf(std::uint64_t key, std::uint64_t multiplier) noexcept
+        {
+            return static_cast<std::size_t>((key * multiplier) >> shift);
+        }
+
+        // Fill the slots using multiplier and return the longest probe sequence needed.
+        constexpr std::size_t place(const NameEntry<Value> (&entries)[N], std::uint64_t multiplier) noexcept
+        {
+            for(auto& slot : slots_)
+                slot = Slot{};
+
+            std::size_t maxProbe = 0;
+            for(const auto& entry : entries)
+            {
+                const std::uint64_t key = packName(entry.name);
+                std::size_t slot = slotOf(key, multiplier);
+                std::size_t probe = 1;
+                while(slots_[slot].key != 0)
+                {
+                    slot = (slot + 1) & (capacity - 1);
+                    ++probe;
+                }
+
+                slots_[slot] = Slot{ key, entry.value };
+                if(probe > maxProbe)
+                    maxProbe = probe;
+            }
+            return maxProbe;
+        }
+
+        std::array<Slot, capacity> slots_{};
+        std::uint64_t multiplier_ = 0;
+        std::size_t maxProbe_ = 0;
+    };
+
+    template <class Value, std::size_t N>
+    constexpr NameTable<Value, N> makeNameTable(const NameEntry<Value> (&entries)[N]) noexcept
+    {
+        return NameTable<Value, N>{ entries };
+    }
+
+    // Month number [1 - 12]
+    inline constexpr auto monthTable = makeNameTable<int>({
+        { "Jan", 1 }, { "Feb", 2 }, { "Mar", 3 }, { "Apr", 4 }, { "May", 5 }, { "Jun", 6 },
+        { "Jul", 7 }, { "Aug", 8 }, { "Sep", 9 }, { "Oct", 10 }, { "Nov", 11 }, { "Dec", 12 } });
+
+    // Day of the week [0 - 6], where 0 is Sunday
+    inline constexpr auto weekdayTable = makeNameTable<int>({
+        { "Sun", 0 }, { "Mon", 1 }, { "Tue", 2 }, { "Wed", 3 }, { "Thu", 4 }, { "Fri", 5 }, { "Sat", 6 } });
+
+    // The RFC882 named zones, as a differential in minutes
+    inline constexpr auto timeZoneTable = makeNameTable<std::int16_t>({
+        { "UT", 0 }, { "GMT", 0 },
+        { "EST", -5 * 60 }, { "EDT", -4 * 60 },
+        { "CST", -6 * 60 }, { "CDT", -5 * 60 },
+        { "MST", -7 * 60 }, { "MDT", -6 * 60 },
+        { "PST", -8 * 60 }, { "PDT", -7 * 60 },
+        { "Z", 0 }, { "A", -1 * 60 }, { "M", -12 * 60 }, { "N", 1 * 60 }, { "Y", 12 * 60 } });
+
+    // Common zone abbreviations that aren't RFC882 zones, as a differential in minutes. Abbreviations are
+    // ambiguous, and where they are this table takes the meaning most often seen in feeds:
+    // IST is India (not Ireland or Israel), BST is British Summer Time (not Bangladesh) and AST is
+    // Atlantic (not Arabia). CST stays North American, since the RFC882 zones come first.
+    // Build a table of your own with makeNameTable() if these don't fit.
+    inline constexpr auto extendedTimeZoneTable = makeNameTable<std::int16_t>({
+        { "UTC", 0 },
+        // Europe
+        { "WET", 0 }, { "WEST", 1 * 60 }, { "BST", 1 * 60 }, { "CET", 1 * 60 }, { "CEST", 2 * 60 },
+        { "MET", 1 * 60 }, { "MEST", 2 * 60 }, { "EET", 2 * 60 }, { "EEST", 3 * 60 }, { "MSK", 3 * 60 },
+        // Africa
+        { "WAT", 1 * 60 }, { "CAT", 2 * 60 }, { "SAST", 2 * 60 }, { "EAT", 3 * 60 },
+        // Asia
+        { "PKT", 5 * 60 }, { "IST", 5 * 60 + 30 }, { "ICT", 7 * 60 }, { "WIB", 7 * 60 }, { "SGT", 8 * 60 },
+        { "HKT", 8 * 60 }, { "PHT", 8 * 60 }, { "JST", 9 * 60 }, { "KST", 9 * 60 },
+        // Australia and New Zealand
+        { "AWST", 8 * 60 }, { "ACST", 9 * 60 + 30 }, { "ACDT", 10 * 60 + 30 }, { "AEST", 10 * 60 }, { "AEDT", 11 * 60 },
+        { "NZST", 12 * 60 }, { "NZDT", 13 * 60 },
+        // Americas
+        { "HST", -10 * 60 }, { "AKST", -9 * 60 }, { "AKDT", -8 * 60 }, { "AST", -4 * 60 }, { "ADT", -3 * 60 },
+        { "NST", -3 * 60 - 30 }, { "NDT", -2 * 60 - 30 }, { "BRT", -3 * 60 }, { "ART", -3 * 60 } });
+
+    static_assert(monthTable.maxProbe() == 1 && weekdayTable.maxProbe() == 1 && timeZoneTable.maxProbe() == 1 &&
+        extendedTimeZoneTable.maxProbe() == 1, "The built-in tables should have perfect hashes");
+
+    // Returns the month number [1 - 12], or 0 if this isn't a month name.
+    constexpr int monthFromName(std::string_view name) noexcept
+    {
+        return monthTable.find(name).value_or(0);
+    }
+
+    // Returns the day of the week [0 - 6] (0 is Sunday), or -1 if this isn't a day name.
+    constexpr int weekdayFromName(std::string_view name) noexcept
+    {
+        return weekdayTable.find(name).value_or(-1);
+    }
+
+    // Named zones only. Returns false if the name isn't one of the RFC882 zones.
+    constexpr bool timeZoneFromName(std::string_view name, std::chrono::minutes& differential) noexcept
+    {
+        if(auto minutes = timeZoneTable.find(name))
+        {
+            differential = std::chrono::minutes{ *minutes };
+            return true;
+        }
+        return false;
+    }
+
+    // Returns false if the name isn't in extendedTimeZoneTable. The RFC882 zones are not included.
+    constexpr bool extendedTimeZoneFromName(std::string_view name, std::chrono::minutes& differential) noexcept
+    {
+        if(auto minutes = extendedTimeZoneTable.find(name))
+        {
+            differential = std::chrono::minutes{ *minutes };
+            return true;
+        }
+        return false;
+    }
+
+    // Returns the name of month [1 - 12], or an empty string if out of range.
+    constexpr std::string_view monthName(int month) noexcept
+    {
+        constexpr std::array<std::string_view, 12> names{ "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        return (month >= 1 && month <= 12) ? names[month - 1] : std::string_view{};
+    }
+
+    // Returns the name of weekday [0 - 6] (0 is Sunday), or an empty string if out of range.
+    constexpr std::string_view weekdayName(int weekday) noexcept
+    {
+        constexpr std::array<std::string_view, 7> names{ "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+        return (weekday >= 0 && weekday <= 6) ? names[weekday] : std::string_view{};
+    }
+}
+
+#endif
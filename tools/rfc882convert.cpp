@@ -0,0 +1,273 @@
+/*
+Bulk converter from newline-separated stamps to packed binary columns.
+
+    rfc882convert [--threads=N] input.txt output.bin
+
+The input is memory-mapped and split at line boundaries into ranges of about 1 MB, which are spread over
+the threads by the work-stealing scheduler of rfc882parallel.h. Lines are parsed in place (a trailing '\r'
+is ignored) and never copied. The output has a fixed 16-byte header followed by
+three columns, all little-endian as written by the host:
+
+    char          magic[8]          "RFC882C1"
+    uint64        count             number of lines
+    int64         epoch[count]      seconds since 1970-01-01 UTC, 0 if the line didn't parse
+    int16         offset[count]     time zone differential in minutes, 0 if the line didn't parse
+    uint8         valid[(count + 7) / 8]
+                                    bit (i % 8) of byte (i / 8) is set if line i parsed
+
+The epoch and offset columns and the validity bitmap use the Arrow buffer layouts, so they can be
+wrapped as Arrow arrays without conversion.
+
+Requires POSIX mmap().
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib> // for std::atoi()
+#include <cstring> // for std::memchr()
+#include <new> // for std::bad_alloc
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../rfc882datetime.h"
+#include "../rfc882parallel.h"
+
+namespace
+{
+    constexpr char magic[8] = { 'R', 'F', 'C', '8', '8', '2', 'C', '1' };
+
+    // Bytes of input per range of lines handed to a thread
+    constexpr std::size_t rangeSize = std::size_t{ 1 } << 20;
+
+    // Read-only mapping of a whole file
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const char* path)
+        {
+            fd_ = ::open(path, O_RDONLY);
+            if(fd_ < 0)
+                return;
+
+            struct stat info;
+            if(::fstat(fd_, &info) != 0)
+                return;
+            size_ = static_cast<std::size_t>(info.st_size);
+            if(size_ == 0)
+            {
+                ok_ = true;
+                return;
+            }
+
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if(data == MAP_FAILED)
+                return;
+            data_ = static_cast<const char*>(data);
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+            ok_ = true;
+        }
+
+        ~MappedFile()
+        {
+            if(data_)
+                ::munmap(const_cast<char*>(data_), size_);
+            if(fd_ >= 0)
+                ::close(fd_);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool ok() const noexcept { return ok_; }
+        std::string_view contents() const noexcept { return { data_, data_ ? size_ : 0 }; }
+
+    private:
+        int fd_ = -1;
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool ok_ = false;
+    };
+
+    // The results of one range of lines
+    struct Columns
+    {
+        std::vector<std::int64_t> epoch;
+        std::vector<std::int16_t> offset;
+        std::vector<std::uint8_t> valid; // one byte per line, packed into bits when written
+        bool outOfMemory = false;
+    };
+
+    // Split text into up to count ranges of about the same size, each ending just after a newline
+    // (or at the end of the text).
+    std::vector<std::string_view> splitLines(std::string_view text, std::size_t count)
+    {
+        std::vector<std::string_view> ranges;
+        std::size_t begin = 0;
+        for(std::size_t i = 1; i <= count && begin < text.size(); ++i)
+        {
+            std::size_t end = text.size();
+            if(i < count)
+            {
+                end = std::max(begin, text.size() / count * i);
+                end = text.find('\n', end);
+                end = (end == std::string_view::npos) ? text.size() : end + 1;
+            }
+            ranges.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+        return ranges;
+    }
+
+    void convertLines(std::string_view text, Columns& out)
+    {
+        const std::size_t estimate = text.size() / 30 + 1;
+        out.epoch.reserve(estimate);
+        out.offset.reserve(estimate);
+        out.valid.reserve(estimate);
+
+        const char* line = text.data();
+        const char* const end = text.data() + text.size();
+        while(line < end)
+        {
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+            const char* lineEnd = newline ? newline : end;
+
+            std::string_view stamp{ line, static_cast<std::size_t>(lineEnd - line) };
+            if(!stamp.empty() && stamp.back() == '\r')
+                stamp.remove_suffix(1);
+
+            const rfc882::ParseResult result = rfc882::parse(stamp);
+            out.epoch.push_back(result.valid ? std::chrono::duration_cast<std::chrono::seconds>(result.time.time_since_epoch()).count() : 0);
+            out.offset.push_back(result.valid ? static_cast<std::int16_t>(result.dateTime.timeZoneDifferential.count()) : 0);
+            out.valid.push_back(result.valid);
+
+            line = lineEnd + 1;
+        }
+    }
+
+    // Runs as a task of runChunks(), so it must not throw: running out of memory is left in out.outOfMemory
+    void convertRange(std::string_view text, Columns& out) noexcept
+    {
+        try
+        {
+            convertLines(text, out);
+        }
+        catch(const std::bad_alloc&)
+        {
+            out = Columns{};
+            out.outOfMemory = true;
+        }
+    }
+
+    bool writeOutput(const char* path, const std::vector<Columns>& columns, std::uint64_t count)
+    {
+        std::FILE* file = std::fopen(path, "wb");
+        if(!file)
+            return false;
+
+        bool ok = std::fwrite(magic, sizeof(magic), 1, file) == 1 && std::fwrite(&count, sizeof(count), 1, file) == 1;
+        for(const auto& range : columns)
+            ok = ok && std::fwrite(range.epoch.data(), sizeof(std::int64_t), range.epoch.size(), file) == range.epoch.size();
+        for(const auto& range : columns)
+            ok = ok && std::fwrite(range.offset.data(), sizeof(std::int16_t), range.offset.size(), file) == range.offset.size();
+
+        // The ranges don't start on byte boundaries of the bitmap, so it is packed across them
+        std::vector<std::uint8_t> bitmap;
+        bitmap.reserve(static_cast<std::size_t>((count + 7) / 8));
+        std::uint8_t bits = 0;
+        std::uint64_t index = 0;
+        for(const auto& range : columns)
+        {
+            for(const std::uint8_t valid : range.valid)
+            {
+                bits |= static_cast<std::uint8_t>(valid << (index % 8));
+                if(++index % 8 == 0)
+                {
+                    bitmap.push_back(bits);
+                    bits = 0;
+                }
+            }
+        }
+        if(index % 8 != 0)
+            bitmap.push_back(bits);
+        ok = ok && std::fwrite(bitmap.data(), 1, bitmap.size(), file) == bitmap.size();
+
+        return std::fclose(file) == 0 && ok;
+    }
+
+    double gigabytesPerSecond(std::size_t bytes, std::chrono::steady_clock::duration elapsed)
+    {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0 ? static_cast<double>(bytes) / seconds / 1e9 : 0.0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<const char*> paths;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg{ argv[i] };
+        if(arg.substr(0, 10) == "--threads=")
+            threads = std::max(1, std::atoi(argv[i] + 10));
+        else
+            paths.push_back(argv[i]);
+    }
+    if(paths.size() != 2)
+    {
+        std::fprintf(stderr, "usage: %s [--threads=N] input output\n", argv[0]);
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const MappedFile input{ paths[0] };
+    if(!input.ok())
+    {
+        std::fprintf(stderr, "%s: can't read %s\n", argv[0], paths[0]);
+        return 1;
+    }
+
+    const std::size_t rangeCount = std::max<std::size_t>(threads, input.contents().size() / rangeSize);
+    const std::vector<std::string_view> ranges = splitLines(input.contents(), rangeCount);
+    std::vector<Columns> columns(ranges.size());
+    rfc882::detail::runChunks(ranges.size(), threads, [&ranges, &columns](std::size_t range) {
+        convertRange(ranges[range], columns[range]);
+    });
+    const auto parsed = std::chrono::steady_clock::now();
+    if(std::any_of(columns.begin(), columns.end(), [](const Columns& range) { return range.outOfMemory; }))
+    {
+        std::fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    std::uint64_t count = 0;
+    std::uint64_t valid = 0;
+    for(const auto& range : columns)
+    {
+        count += range.valid.size();
+        valid += static_cast<std::uint64_t>(std::count(range.valid.begin(), range.valid.end(), 1));
+    }
+
+    if(!writeOutput(paths[1], columns, count))
+    {
+        std::fprintf(stderr, "%s: can't write %s\n", argv[0], paths[1]);
+        return 1;
+    }
+    const auto written = std::chrono::steady_clock::now();
+
+    const std::size_t bytes = input.contents().size();
+    std::fprintf(stderr, "%llu stamps (%llu valid), %zu bytes, %u threads: parse %.3f GB/s, total %.3f GB/s\n",
+        static_cast<unsigned long long>(count), static_cast<unsigned long long>(valid), bytes, threads,
+        gigabytesPerSecond(bytes, parsed - start), gigabytesPerSecond(bytes, written - start));
+    return 0;
+}